@@ -1,16 +1,36 @@
 #ifndef CHAIN_HPP_
 #define CHAIN_HPP_
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <vector>
 
 using Temperature = double;
 
 class DeviceHandler
 {
+    using BlockMatcher = std::function<void(const Temperature*, size_t, uint8_t*)>;
+
+    // evaluates the matcher for a whole block of temperatures - a branch-free loop over an inlined
+    // comparison, so the compiler can vectorize it
+    template <typename TCanHandle>
+    static BlockMatcher make_block_matcher(const TCanHandle& can_handle)
+    {
+        return [can_handle](const Temperature* temperatures, size_t count, uint8_t* mask) {
+            const auto matcher = can_handle; // local copy - writes to mask cannot alias matcher's thresholds
+
+            for (size_t i = 0; i < count; ++i)
+                mask[i] = static_cast<bool>(matcher(temperatures[i])); // exactly 0 or 1 - masks are summed as counts
+        };
+    }
+
+    BlockMatcher match_block_;
     std::function<bool(Temperature)> can_handle_;
     std::function<void(Temperature)> handler_;
 
@@ -19,7 +39,8 @@ class DeviceHandler
 public:
     template <typename TCanHandle, typename TEventHandler>
     DeviceHandler(TCanHandle&& can_handle, TEventHandler&& handler)
-        : can_handle_{std::forward<TCanHandle>(can_handle)}
+        : match_block_{make_block_matcher(can_handle)}
+        , can_handle_{std::forward<TCanHandle>(can_handle)}
         , handler_{std::forward<TEventHandler>(handler)}
     { }
 
@@ -39,14 +60,36 @@ public:
         }
     }
 
+    void match_block(const Temperature* temperatures, size_t count, uint8_t* mask) const
+    {
+        match_block_(temperatures, count, mask);
+    }
+
+    void handle(Temperature temperature) const
+    {
+        handler_(temperature);
+    }
+
+    DeviceHandler* next_handler() const
+    {
+        return next_event_handler_.get();
+    }
+
     ~DeviceHandler() = default;
 };
 
 class Device
 {
+    static constexpr size_t batch_block_size = 256;
+
     std::string id_;
     std::shared_ptr<DeviceHandler> handler_;
 
+    // buffers reused by on_temperature_batch()
+    std::vector<const DeviceHandler*> batch_handlers_;
+    std::vector<const DeviceHandler*> batch_selected_;
+    std::vector<uint8_t> batch_masks_; // batch_masks_[h * block_size + i] - handler h matches event i
+
 public:
     Device(std::string id)
         : id_{id}
@@ -66,6 +109,98 @@ public:
         if (handler_)
             handler_->on_temperature_event(temperature);
     }
+
+    // Calls handlers for every temperature in order, in chain order.
+    // Events are processed in blocks: every matcher is evaluated for the whole block first
+    // (one match mask per handler), then handlers are called event by event. Matchers therefore
+    // run before any handler of the block - the result is the same as calling on_temperature_change()
+    // for every temperature only when matchers are pure (do not depend on state changed by handlers).
+    void on_temperature_batch(std::span<const Temperature> temperatures)
+    {
+        const size_t count = temperatures.size();
+
+        batch_handlers_.clear();
+        for (const DeviceHandler* handler = handler_.get(); handler; handler = handler->next_handler())
+            batch_handlers_.push_back(handler);
+        batch_selected_.resize(batch_handlers_.size());
+
+        const size_t handlers_count = batch_handlers_.size();
+
+        for (size_t offset = 0; offset < count; offset += batch_block_size)
+        {
+            const Temperature* block = temperatures.data() + offset;
+            const size_t block_size = std::min(batch_block_size, count - offset);
+
+            batch_masks_.resize(handlers_count * block_size);
+            for (size_t h = 0; h < handlers_count; ++h)
+                batch_handlers_[h]->match_block(block, block_size, &batch_masks_[h * block_size]);
+
+            for (size_t i = 0; i < block_size; ++i)
+            {
+                // branch-free selection of matching handlers - the masks are unpredictable for the branch predictor
+                size_t selected_count = 0;
+                for (size_t h = 0; h < handlers_count; ++h)
+                {
+                    batch_selected_[selected_count] = batch_handlers_[h];
+                    selected_count += batch_masks_[h * block_size + i];
+                }
+
+                for (size_t s = 0; s < selected_count; ++s)
+                    batch_selected_[s]->handle(block[i]);
+            }
+        }
+    }
+};
+
+// Drop-in alternative to Device with handlers stored contiguously in a vector.
+// Links between handlers are indexes - dispatch is a loop and destruction just destroys
+// the vector, so long chains cannot overflow the stack.
+class DeviceHandlerChain
+{
+    using HandlerIndex = uint32_t;
+    static constexpr HandlerIndex npos = static_cast<HandlerIndex>(-1);
+
+    struct Link
+    {
+        std::function<bool(Temperature)> can_handle;
+        std::function<void(Temperature)> handler;
+        HandlerIndex next;
+    };
+
+    std::string id_;
+    std::vector<Link> links_;
+    HandlerIndex head_ = npos;
+
+public:
+    DeviceHandlerChain(std::string id)
+        : id_{id}
+    {
+    }
+
+    // the most recently added handler is called first - as in Device
+    template <typename TCanHandle, typename TDeviceHandler>
+    void add_handler(TCanHandle&& can_handle, TDeviceHandler&& handler)
+    {
+        const auto index = static_cast<HandlerIndex>(links_.size());
+        links_.push_back(Link{std::forward<TCanHandle>(can_handle), std::forward<TDeviceHandler>(handler), head_});
+        head_ = index;
+    }
+
+    size_t handlers_count() const
+    {
+        return links_.size();
+    }
+
+    void on_temperature_change(Temperature temperature)
+    {
+        for (HandlerIndex index = head_; index != npos; index = links_[index].next)
+        {
+            const Link& link = links_[index];
+
+            if (link.can_handle(temperature))
+                link.handler(temperature);
+        }
+    }
 };
 
 #endif /*CHAIN_HPP_*/
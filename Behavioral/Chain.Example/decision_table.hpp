@@ -0,0 +1,145 @@
+#ifndef DECISION_TABLE_HPP_
+#define DECISION_TABLE_HPP_
+
+#include "chain.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+// Compiled alternative to the DeviceHandler chain.
+// Thresholds of all matchers split the temperature axis into intervals:
+//   (-inf, t0), [t0], (t0, t1), [t1], ... , (tn, +inf) and an extra one for NaN
+// The value of every matcher is constant inside an interval, so the table stores for each interval
+// the list of handlers to fire. An event is resolved with one binary search.
+// Handlers fire in the same order as in Device - the most recently added one first.
+// Only matchers from Matchers namespace (reporting their thresholds) can be compiled.
+class DecisionTable
+{
+    using HandlerIndex = uint32_t;
+
+    struct Rule
+    {
+        std::function<bool(Temperature)> matcher; // used only during compilation
+        std::function<void(Temperature)> handler;
+    };
+
+    std::vector<Rule> rules_; // in order of adding
+    std::vector<Temperature> thresholds_; // sorted, unique
+    std::vector<uint32_t> interval_offsets_; // handlers of interval i: [interval_offsets_[i], interval_offsets_[i + 1])
+    std::vector<HandlerIndex> interval_handlers_;
+    bool is_compiled_ = false;
+
+    size_t nan_interval() const
+    {
+        return 2 * thresholds_.size() + 1;
+    }
+
+    size_t interval_index(Temperature temperature) const
+    {
+        if (std::isnan(temperature))
+            return nan_interval();
+
+        auto pos = std::lower_bound(thresholds_.begin(), thresholds_.end(), temperature);
+        auto index = static_cast<size_t>(pos - thresholds_.begin());
+
+        return (pos != thresholds_.end() && *pos == temperature) ? 2 * index + 1 : 2 * index;
+    }
+
+    // any temperature lying inside the interval
+    Temperature representative(size_t interval) const
+    {
+        constexpr auto inf = std::numeric_limits<Temperature>::infinity();
+
+        if (interval == nan_interval())
+            return std::numeric_limits<Temperature>::quiet_NaN();
+
+        const size_t index = interval / 2;
+
+        if (interval % 2 == 1)
+            return thresholds_[index];
+
+        if (thresholds_.empty())
+            return 0.0;
+
+        if (index == 0)
+            return std::nextafter(thresholds_.front(), -inf);
+
+        if (index == thresholds_.size())
+            return std::nextafter(thresholds_.back(), inf);
+
+        // an empty interval (neighbouring doubles) may get a wrong representative - it is never looked up
+        const Temperature lower = thresholds_[index - 1];
+        const Temperature upper = thresholds_[index];
+
+        // a midpoint of an infinite bound is infinite - step from the finite one instead
+        if (std::isinf(lower))
+            return std::nextafter(upper, -inf);
+
+        if (std::isinf(upper))
+            return std::nextafter(lower, inf);
+
+        return std::midpoint(lower, upper); // no overflow for bounds of large opposite magnitudes
+    }
+
+public:
+    template <typename TMatcher, typename TDeviceHandler>
+    void add_handler(TMatcher&& matcher, TDeviceHandler&& handler)
+    {
+        matcher.collect_thresholds(thresholds_);
+        rules_.push_back(Rule{std::forward<TMatcher>(matcher), std::forward<TDeviceHandler>(handler)});
+        is_compiled_ = false;
+    }
+
+    size_t handlers_count() const
+    {
+        return rules_.size();
+    }
+
+    size_t intervals_count() const
+    {
+        return interval_offsets_.empty() ? 0 : interval_offsets_.size() - 1;
+    }
+
+    void compile()
+    {
+        thresholds_.erase(std::remove_if(thresholds_.begin(), thresholds_.end(), [](Temperature t) { return std::isnan(t); }), thresholds_.end());
+        std::sort(thresholds_.begin(), thresholds_.end());
+        thresholds_.erase(std::unique(thresholds_.begin(), thresholds_.end()), thresholds_.end());
+
+        interval_offsets_.assign(1, 0);
+        interval_handlers_.clear();
+
+        for (size_t interval = 0; interval <= nan_interval(); ++interval)
+        {
+            const Temperature temperature = representative(interval);
+
+            for (size_t i = rules_.size(); i-- > 0;)
+                if (rules_[i].matcher(temperature))
+                    interval_handlers_.push_back(static_cast<HandlerIndex>(i));
+
+            interval_offsets_.push_back(static_cast<uint32_t>(interval_handlers_.size()));
+        }
+
+        is_compiled_ = true;
+    }
+
+    void on_temperature_change(Temperature temperature)
+    {
+        if (!is_compiled_)
+            compile();
+
+        const size_t interval = interval_index(temperature);
+        const auto first = interval_offsets_[interval];
+        const auto last = interval_offsets_[interval + 1];
+
+        for (auto i = first; i != last; ++i)
+            rules_[interval_handlers_[i]].handler(temperature);
+    }
+};
+
+#endif /*DECISION_TABLE_HPP_*/
@@ -1,8 +1,19 @@
 #include "chain.hpp"
+#include "decision_table.hpp"
+#include "matchers.hpp"
+#include "rule_engine.hpp"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
@@ -68,49 +79,244 @@ public:
     }
 };
 
-namespace Matchers
+template <typename TDevice>
+void add_random_rules(TDevice& device, size_t rules_count, uint64_t& checksum)
 {
-    template <typename Compare>
-    struct Comparer
+    using namespace Matchers;
+
+    std::mt19937_64 rnd{665};
+    std::uniform_real_distribution<Temperature> threshold_distr{-20.0, 60.0};
+    auto threshold = [&] { return std::round(threshold_distr(rnd) * 2.0) / 2.0; };
+
+    for (size_t i = 0; i < rules_count; ++i)
     {
-        auto operator()(Temperature temperature) const
+        auto handler = [&checksum, i](Temperature) { checksum = checksum * 31 + i; };
+        const Temperature t1 = threshold();
+        const Temperature t2 = threshold();
+
+        switch (i % 5)
         {
-            return [temperature, compare = Compare{}](Temperature value) {
-                return compare(value, temperature);
-            };
+        case 0:
+            device.add_handler(Ge(t1), handler);
+            break;
+        case 1:
+            device.add_handler(Lt(t1), handler);
+            break;
+        case 2:
+            device.add_handler(And(Ge(std::min(t1, t2)), Lt(std::max(t1, t2))), handler);
+            break;
+        case 3:
+            device.add_handler(Or(Le(std::min(t1, t2)), Gt(std::max(t1, t2))), handler);
+            break;
+        case 4:
+            device.add_handler(Not(Or(Eq(t1), And(Gt(t2), Le(t2 + 5.0)))), handler);
+            break;
         }
-    };
+    }
+}
 
-    auto _ = [](Temperature temperature) {
-        return true;
-    };
-    // auto Lt = [](Temperature value) { return [value](Temperature temperature) { return temperature < value; }; };
-    auto Lt = Comparer<std::less<>>{};
-    auto Le = Comparer<std::less_equal<>>{};
-    auto Gt = Comparer<std::greater<>>{};
-    auto Ge = Comparer<std::greater_equal<>>{};
-    auto Eq = Comparer<std::equal_to<>>{};
-
-    auto And = [](auto&& lhs, auto&& rhs) {
-        return [lhs = std::forward<decltype(lhs)>(lhs), rhs = std::forward<decltype(rhs)>(rhs)](Temperature temperature) {
-            return lhs(temperature) && rhs(temperature);
-        };
-    };
+void benchmark_decision_table(size_t rules_count)
+{
+    constexpr size_t events_count = 100'000;
 
-    auto Or = [](auto&& lhs, auto&& rhs) {
-        return [lhs = std::forward<decltype(lhs)>(lhs), rhs = std::forward<decltype(rhs)>(rhs)](Temperature temperature) {
-            return lhs(temperature) || rhs(temperature);
-        };
-    };
+    std::mt19937_64 rnd{42};
+    std::uniform_real_distribution<Temperature> temperature_distr{-25.0, 65.0};
+    std::vector<Temperature> temperatures(events_count);
+    for (auto& t : temperatures)
+        t = std::round(temperature_distr(rnd) * 4.0) / 4.0; // hits thresholds exactly from time to time
 
-    auto Not = [](auto&& pred) {
-        return [pred = std::forward<decltype(pred)>(pred)](Temperature temperature) {
-            return !pred(temperature);
-        };
-    };
-} // namespace Matchers
+    uint64_t chain_checksum = 0;
+    Device device{"chain"};
+    add_random_rules(device, rules_count, chain_checksum);
+
+    uint64_t table_checksum = 0;
+    DecisionTable table;
+    add_random_rules(table, rules_count, table_checksum);
+    table.compile();
+
+    auto start = chrono::steady_clock::now();
+    for (auto t : temperatures)
+        device.on_temperature_change(t);
+    chrono::duration<double, nano> chain_time = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (auto t : temperatures)
+        table.on_temperature_change(t);
+    chrono::duration<double, nano> table_time = chrono::steady_clock::now() - start;
+
+    cout << "Rules: " << rules_count << " (" << table.intervals_count() << " intervals)"
+         << " - chain: " << chain_time.count() / events_count << "ns per event"
+         << ", decision table: " << table_time.count() / events_count << "ns per event"
+         << (chain_checksum == table_checksum ? " - the same handlers fired" : " - RESULTS DIFFER!") << '\n';
+}
+
+// alarm-like rules - every rule matches a narrow band of temperatures, so handlers fire rarely
+template <typename TDevice>
+void add_band_rules(TDevice& device, size_t rules_count, uint64_t& checksum)
+{
+    using namespace Matchers;
+
+    std::mt19937_64 rnd{665};
+    std::uniform_real_distribution<Temperature> threshold_distr{-20.0, 60.0};
+
+    for (size_t i = 0; i < rules_count; ++i)
+    {
+        const Temperature lower = threshold_distr(rnd);
+        device.add_handler(And(Ge(lower), Lt(lower + 0.5)), [&checksum, i](Temperature) { checksum = checksum * 31 + i; });
+    }
+}
+
+using AddRules = void (*)(Device&, size_t, uint64_t&);
+
+void benchmark_batch_processing(const string& rules_name, AddRules add_rules, size_t rules_count)
+{
+    constexpr size_t events_count = 100'000;
+
+    std::mt19937_64 rnd{42};
+    std::uniform_real_distribution<Temperature> temperature_distr{-25.0, 65.0};
+    std::vector<Temperature> temperatures(events_count);
+    for (auto& t : temperatures)
+        t = temperature_distr(rnd);
+
+    uint64_t per_event_checksum = 0;
+    Device per_event_device{"per event"};
+    add_rules(per_event_device, rules_count, per_event_checksum);
+
+    uint64_t batch_checksum = 0;
+    Device batch_device{"batch"};
+    add_rules(batch_device, rules_count, batch_checksum);
+
+    auto start = chrono::steady_clock::now();
+    for (auto t : temperatures)
+        per_event_device.on_temperature_change(t);
+    chrono::duration<double, nano> per_event_time = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    batch_device.on_temperature_batch(temperatures);
+    chrono::duration<double, nano> batch_time = chrono::steady_clock::now() - start;
+
+    cout << "Rules: " << rules_count << " " << rules_name
+         << " - per event: " << per_event_time.count() / events_count << "ns per event"
+         << ", batch: " << batch_time.count() / events_count << "ns per event"
+         << (per_event_checksum == batch_checksum ? " - the same handlers fired" : " - RESULTS DIFFER!") << '\n';
+}
+
+void fleet_rule_engine_benchmark(size_t devices_count, size_t shards_count, size_t producers_count)
+{
+    using namespace Matchers;
 
-int main()
+    constexpr size_t events_per_producer = 1'000'000;
+    constexpr ActuatorId heater = 0;
+    constexpr ActuatorId fan_1 = 1;
+    constexpr ActuatorId fan_2 = 2;
+
+    // the same rules as for the single device above
+    RuleSet rules;
+    rules.add_rule(Lt(19.0), {{heater, 1}, {fan_1, 0}, {fan_2, 0}});
+    rules.add_rule(Ge(20.0), {{heater, 0}});
+    rules.add_rule(And(Ge(22.5), Lt(25.0)), {{fan_1, 5}, {fan_2, 0}});
+    rules.add_rule(Ge(25.0), {{fan_1, 10}, {fan_2, 10}});
+
+    std::atomic<size_t> commands_count{0};
+    std::vector<ShardStats> stats;
+    chrono::duration<double> elapsed{};
+    {
+        RuleEngine engine{rules, devices_count, [&commands_count](const ActuatorCommand&) { commands_count.fetch_add(1, std::memory_order_relaxed); }, shards_count};
+
+        auto start = chrono::steady_clock::now();
+
+        std::vector<std::thread> producers;
+        for (size_t p = 0; p < producers_count; ++p)
+        {
+            producers.emplace_back([&engine, p, devices_count, producers_count] {
+                // every producer owns a subset of devices and simulates their readings as random walks
+                std::mt19937_64 rnd{p};
+                std::normal_distribution<Temperature> change_distr{0.0, 0.25};
+                std::vector<Temperature> temperatures(devices_count, 21.0);
+
+                for (size_t i = 0; i < events_per_producer; ++i)
+                {
+                    const auto device_index = static_cast<uint32_t>((i * producers_count + p) % devices_count);
+                    auto& t = temperatures[device_index];
+                    t = std::clamp(t + change_distr(rnd), 10.0, 35.0);
+                    engine.post(device_index, t);
+                }
+            });
+        }
+
+        for (auto& producer : producers)
+            producer.join();
+
+        engine.wait_idle();
+        elapsed = chrono::steady_clock::now() - start;
+        stats = engine.stats();
+    }
+
+    const size_t events_count = events_per_producer * producers_count;
+    cout << "Fleet of " << devices_count << " devices, " << shards_count << " shards, " << producers_count << " producers: "
+         << events_count / elapsed.count() / 1e6 << "M events/s, actuator commands: " << commands_count << '\n';
+
+    for (size_t i = 0; i < stats.size(); ++i)
+    {
+        const auto& shard = stats[i];
+        cout << "  shard #" << i << " - devices: " << shard.devices_count
+             << ", events: " << shard.events_processed
+             << ", " << shard.events_per_second / 1e6 << "M events/s"
+             << ", queue depth: " << shard.queue_depth << " (max " << shard.max_queue_depth << ")"
+             << ", commands emitted: " << shard.commands_emitted
+             << ", suppressed: " << shard.commands_suppressed << '\n';
+    }
+}
+
+void benchmark_long_chain(size_t handlers_count)
+{
+    constexpr size_t events_count = 1'000;
+
+    std::mt19937_64 rnd{42};
+    std::uniform_real_distribution<Temperature> temperature_distr{-25.0, 65.0};
+    std::vector<Temperature> temperatures(events_count);
+    for (auto& t : temperatures)
+        t = temperature_distr(rnd);
+
+    uint64_t linked_checksum = 0;
+    chrono::duration<double, micro> linked_dispatch_time{}, linked_teardown_time{};
+    {
+        auto device = std::make_unique<Device>("linked");
+        add_band_rules(*device, handlers_count, linked_checksum);
+
+        auto start = chrono::steady_clock::now();
+        for (auto t : temperatures)
+            device->on_temperature_change(t);
+        linked_dispatch_time = chrono::steady_clock::now() - start;
+
+        start = chrono::steady_clock::now();
+        device.reset();
+        linked_teardown_time = chrono::steady_clock::now() - start;
+    }
+
+    uint64_t vector_checksum = 0;
+    chrono::duration<double, micro> vector_dispatch_time{}, vector_teardown_time{};
+    {
+        auto device = std::make_unique<DeviceHandlerChain>("vector");
+        add_band_rules(*device, handlers_count, vector_checksum);
+
+        auto start = chrono::steady_clock::now();
+        for (auto t : temperatures)
+            device->on_temperature_change(t);
+        vector_dispatch_time = chrono::steady_clock::now() - start;
+
+        start = chrono::steady_clock::now();
+        device.reset();
+        vector_teardown_time = chrono::steady_clock::now() - start;
+    }
+
+    cout << "Chain of " << handlers_count << " handlers"
+         << " - linked: " << linked_dispatch_time.count() / events_count << "us per event, teardown " << linked_teardown_time.count() << "us"
+         << "; vector: " << vector_dispatch_time.count() / events_count << "us per event, teardown " << vector_teardown_time.count() << "us"
+         << (linked_checksum == vector_checksum ? " - the same handlers fired" : " - RESULTS DIFFER!") << '\n';
+}
+
+int main(int argc, char* argv[])
 {
     std::cout << "Start...\n";
 
@@ -201,4 +407,21 @@ int main()
 
     for (const auto& t : temperatures)
         device.on_temperature_change(t);
+
+    // benchmarks run for more than 10 seconds in a debug build - they are run on request only
+    if (argc < 2 || std::string{argv[1]} != "--benchmark")
+        return 0;
+
+    for (size_t rules_count : {10u, 100u, 500u})
+        benchmark_decision_table(rules_count);
+
+    for (size_t rules_count : {10u, 100u})
+    {
+        benchmark_batch_processing("random", add_random_rules<Device>, rules_count);
+        benchmark_batch_processing("narrow band", add_band_rules<Device>, rules_count);
+    }
+
+    fleet_rule_engine_benchmark(10'000, 4, 2);
+
+    benchmark_long_chain(10'000);
 }
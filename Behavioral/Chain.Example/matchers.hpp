@@ -0,0 +1,128 @@
+#ifndef MATCHERS_HPP_
+#define MATCHERS_HPP_
+
+#include "chain.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace Matchers
+{
+    // Every matcher is a plain callable that also reports the thresholds it compares against.
+    // Between two neighbouring thresholds the result of a matcher cannot change - DecisionTable relies on it.
+
+    template <typename Compare>
+    struct Threshold
+    {
+        Temperature threshold;
+
+        bool operator()(Temperature value) const
+        {
+            return Compare{}(value, threshold);
+        }
+
+        void collect_thresholds(std::vector<Temperature>& thresholds) const
+        {
+            thresholds.push_back(threshold);
+        }
+    };
+
+    template <typename Compare>
+    struct Comparer
+    {
+        constexpr Threshold<Compare> operator()(Temperature temperature) const
+        {
+            return Threshold<Compare>{temperature};
+        }
+    };
+
+    struct Any
+    {
+        bool operator()(Temperature) const
+        {
+            return true;
+        }
+
+        void collect_thresholds(std::vector<Temperature>&) const
+        {
+        }
+    };
+
+    template <typename TLhs, typename TRhs>
+    struct Conjunction
+    {
+        TLhs lhs;
+        TRhs rhs;
+
+        bool operator()(Temperature temperature) const
+        {
+            // no short-circuit: both operands are always evaluated (keeps block evaluation branch-free),
+            // so rhs must not rely on lhs to guard it
+            return lhs(temperature) & rhs(temperature);
+        }
+
+        void collect_thresholds(std::vector<Temperature>& thresholds) const
+        {
+            lhs.collect_thresholds(thresholds);
+            rhs.collect_thresholds(thresholds);
+        }
+    };
+
+    template <typename TLhs, typename TRhs>
+    struct Disjunction
+    {
+        TLhs lhs;
+        TRhs rhs;
+
+        bool operator()(Temperature temperature) const
+        {
+            // no short-circuit: both operands are always evaluated (keeps block evaluation branch-free),
+            // so rhs must not rely on lhs to guard it
+            return lhs(temperature) | rhs(temperature);
+        }
+
+        void collect_thresholds(std::vector<Temperature>& thresholds) const
+        {
+            lhs.collect_thresholds(thresholds);
+            rhs.collect_thresholds(thresholds);
+        }
+    };
+
+    template <typename TPred>
+    struct Negation
+    {
+        TPred pred;
+
+        bool operator()(Temperature temperature) const
+        {
+            return !pred(temperature);
+        }
+
+        void collect_thresholds(std::vector<Temperature>& thresholds) const
+        {
+            pred.collect_thresholds(thresholds);
+        }
+    };
+
+    inline constexpr Any _{};
+
+    inline constexpr auto Lt = Comparer<std::less<>>{};
+    inline constexpr auto Le = Comparer<std::less_equal<>>{};
+    inline constexpr auto Gt = Comparer<std::greater<>>{};
+    inline constexpr auto Ge = Comparer<std::greater_equal<>>{};
+    inline constexpr auto Eq = Comparer<std::equal_to<>>{};
+
+    inline constexpr auto And = [](auto lhs, auto rhs) {
+        return Conjunction<decltype(lhs), decltype(rhs)>{lhs, rhs};
+    };
+
+    inline constexpr auto Or = [](auto lhs, auto rhs) {
+        return Disjunction<decltype(lhs), decltype(rhs)>{lhs, rhs};
+    };
+
+    inline constexpr auto Not = [](auto pred) {
+        return Negation<decltype(pred)>{pred};
+    };
+} // namespace Matchers
+
+#endif /*MATCHERS_HPP_*/
@@ -0,0 +1,107 @@
+#ifndef MPSC_QUEUE_HPP_
+#define MPSC_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Bounded lock-free queue: many producers, a single consumer.
+// Every cell has a sequence number telling whether it is free for the producer
+// that claimed its position or already filled for the consumer (D. Vyukov's bounded queue).
+template <typename T>
+class MpscQueue
+{
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    const size_t mask_;
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0}; // written only by the consumer
+
+    static size_t round_up_to_power_of_2(size_t value)
+    {
+        size_t result = 2;
+        while (result < value)
+            result *= 2;
+        return result;
+    }
+
+public:
+    explicit MpscQueue(size_t capacity)
+        : cells_{new Cell[round_up_to_power_of_2(capacity)]}
+        , mask_{round_up_to_power_of_2(capacity) - 1}
+    {
+        for (size_t i = 0; i <= mask_; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // returns false when the queue is full
+    bool try_push(const T& value)
+    {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false;
+            else
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // must be called by the consumer thread only; returns false when the queue is empty
+    bool try_pop(T& value)
+    {
+        const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[pos & mask_];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1) < 0)
+            return false;
+
+        value = cell.value;
+        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    // approximate number of queued items - may be called from any thread
+    size_t size_approx() const
+    {
+        const size_t dequeue_pos = dequeue_pos_.load(std::memory_order_relaxed);
+        const size_t enqueue_pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+        return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+    }
+
+    size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+};
+
+#endif /*MPSC_QUEUE_HPP_*/
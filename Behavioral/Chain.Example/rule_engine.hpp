@@ -0,0 +1,296 @@
+#ifndef RULE_ENGINE_HPP_
+#define RULE_ENGINE_HPP_
+
+#include "decision_table.hpp"
+#include "mpsc_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using ActuatorId = uint16_t;
+
+struct ActuatorSetting
+{
+    ActuatorId actuator;
+    int32_t value;
+};
+
+struct ActuatorCommand
+{
+    uint32_t device_index;
+    ActuatorId actuator;
+    int32_t value;
+};
+
+struct TemperatureEvent
+{
+    uint32_t device_index;
+    Temperature temperature;
+};
+
+// Rules shared by all devices: when a matcher accepts a temperature, actuators get the given values.
+// Rules fire in the same order as Device handlers - the most recently added first.
+class RuleSet
+{
+    using RuleInstaller = std::function<void(DecisionTable&, std::function<void(Temperature)>)>;
+
+    struct Rule
+    {
+        RuleInstaller install;
+        std::vector<ActuatorSetting> actions;
+    };
+
+    std::vector<Rule> rules_;
+    size_t actuators_count_ = 0;
+
+public:
+    template <typename TMatcher>
+    void add_rule(TMatcher matcher, std::vector<ActuatorSetting> actions)
+    {
+        for (const auto& action : actions)
+            actuators_count_ = std::max<size_t>(actuators_count_, action.actuator + 1u);
+
+        auto install = [matcher](DecisionTable& table, std::function<void(Temperature)> handler) {
+            table.add_handler(matcher, std::move(handler));
+        };
+
+        rules_.push_back(Rule{std::move(install), std::move(actions)});
+    }
+
+    size_t actuators_count() const
+    {
+        return actuators_count_;
+    }
+
+    // handler_factory(actions) - creates a handler executing the actions of a rule
+    template <typename THandlerFactory>
+    DecisionTable compile(THandlerFactory handler_factory) const
+    {
+        DecisionTable table;
+        for (const auto& rule : rules_)
+            rule.install(table, handler_factory(rule.actions));
+        table.compile();
+
+        return table;
+    }
+};
+
+struct ShardStats
+{
+    size_t devices_count = 0;
+    size_t events_processed = 0;
+    double events_per_second = 0.0;
+    size_t queue_depth = 0;
+    size_t max_queue_depth = 0;
+    size_t commands_emitted = 0;
+    size_t commands_suppressed = 0; // actuator was already in the requested state
+};
+
+// Rule engine for a fleet of devices.
+// Devices are partitioned across shards (device_index % shards_count); every shard has a worker thread
+// and a lock-free inbox, so the state of a device is only touched by one thread.
+// Actuator commands are edge-triggered: a command is emitted only when the final state requested
+// for an event differs from the current state of the actuator (all actuators start at 0).
+// The command sink is called from worker threads.
+class RuleEngine
+{
+public:
+    using CommandSink = std::function<void(const ActuatorCommand&)>;
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct Shard
+    {
+        MpscQueue<TemperatureEvent> inbox;
+        DecisionTable rules;
+        std::vector<int32_t> actuator_states; // [local device index * actuators_count + actuator]
+        std::vector<ActuatorSetting> requested_settings; // last setting per actuator for the current event
+
+        std::atomic<size_t> events_posted{0};
+        std::atomic<size_t> events_processed{0};
+        std::atomic<size_t> max_queue_depth{0};
+        std::atomic<size_t> commands_emitted{0};
+        std::atomic<size_t> commands_suppressed{0};
+        std::thread worker;
+
+        explicit Shard(size_t inbox_capacity)
+            : inbox{inbox_capacity}
+        {
+        }
+    };
+
+    const size_t devices_count_;
+    const size_t actuators_count_;
+    CommandSink sink_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<bool> is_stopped_{false};
+    const Clock::time_point start_time_ = Clock::now();
+
+    void request(Shard& shard, const std::vector<ActuatorSetting>& actions)
+    {
+        for (const auto& action : actions)
+        {
+            auto pos = std::find_if(shard.requested_settings.begin(), shard.requested_settings.end(),
+                [&action](const ActuatorSetting& s) { return s.actuator == action.actuator; });
+
+            if (pos != shard.requested_settings.end())
+                pos->value = action.value;
+            else
+                shard.requested_settings.push_back(action);
+        }
+    }
+
+    void process(Shard& shard, const TemperatureEvent& event)
+    {
+        shard.requested_settings.clear();
+        shard.rules.on_temperature_change(event.temperature);
+
+        if (shard.requested_settings.empty())
+            return;
+
+        const size_t local_index = event.device_index / shards_.size();
+        int32_t* states = &shard.actuator_states[local_index * actuators_count_];
+
+        for (const auto& setting : shard.requested_settings)
+        {
+            if (states[setting.actuator] == setting.value)
+            {
+                shard.commands_suppressed.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            states[setting.actuator] = setting.value;
+            shard.commands_emitted.fetch_add(1, std::memory_order_relaxed);
+            sink_(ActuatorCommand{event.device_index, setting.actuator, setting.value});
+        }
+    }
+
+    void run_shard(Shard& shard)
+    {
+        TemperatureEvent event;
+        size_t idle_polls = 0;
+
+        while (true)
+        {
+            if (shard.inbox.try_pop(event))
+            {
+                idle_polls = 0;
+
+                const size_t queue_depth = std::min(shard.inbox.size_approx() + 1, shard.inbox.capacity());
+                if (queue_depth > shard.max_queue_depth.load(std::memory_order_relaxed))
+                    shard.max_queue_depth.store(queue_depth, std::memory_order_relaxed);
+
+                process(shard, event);
+                shard.events_processed.fetch_add(1, std::memory_order_release);
+                continue;
+            }
+
+            if (is_stopped_.load(std::memory_order_acquire))
+                return; // inbox is drained
+
+            if (++idle_polls < 64)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+public:
+    RuleEngine(const RuleSet& rule_set, size_t devices_count, CommandSink sink,
+        size_t shards_count = std::max(1u, std::thread::hardware_concurrency()), size_t inbox_capacity = 4096)
+        : devices_count_{devices_count}
+        , actuators_count_{rule_set.actuators_count()}
+        , sink_{std::move(sink)}
+    {
+        shards_count = std::max<size_t>(shards_count, 1);
+
+        for (size_t i = 0; i < shards_count; ++i)
+        {
+            auto new_shard = std::make_unique<Shard>(inbox_capacity);
+            Shard& shard = *new_shard;
+
+            const size_t shard_devices_count = devices_count / shards_count + (i < devices_count % shards_count ? 1 : 0);
+            shard.actuator_states.assign(shard_devices_count * actuators_count_, 0);
+            shard.rules = rule_set.compile([this, &shard](const std::vector<ActuatorSetting>& actions) {
+                return [this, &shard, actions](Temperature) { request(shard, actions); };
+            });
+
+            shards_.push_back(std::move(new_shard));
+        }
+
+        for (auto& shard : shards_)
+            shard->worker = std::thread{[this, shard = shard.get()] { run_shard(*shard); }};
+    }
+
+    RuleEngine(const RuleEngine&) = delete;
+    RuleEngine& operator=(const RuleEngine&) = delete;
+
+    // events posted before destruction are processed
+    ~RuleEngine()
+    {
+        is_stopped_.store(true, std::memory_order_release);
+
+        for (auto& shard : shards_)
+            shard->worker.join();
+    }
+
+    size_t shards_count() const
+    {
+        return shards_.size();
+    }
+
+    // thread-safe; spins while the inbox of the shard is full
+    void post(uint32_t device_index, Temperature temperature)
+    {
+        if (device_index >= devices_count_)
+            throw std::out_of_range{"Unknown device index"};
+
+        Shard& shard = *shards_[device_index % shards_.size()];
+
+        while (!shard.inbox.try_push(TemperatureEvent{device_index, temperature}))
+            std::this_thread::yield();
+
+        shard.events_posted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // waits until all events posted so far are processed
+    void wait_idle() const
+    {
+        for (const auto& shard : shards_)
+            while (shard->events_processed.load(std::memory_order_acquire) < shard->events_posted.load(std::memory_order_relaxed))
+                std::this_thread::yield();
+    }
+
+    std::vector<ShardStats> stats() const
+    {
+        const std::chrono::duration<double> elapsed = Clock::now() - start_time_;
+
+        std::vector<ShardStats> stats;
+        for (size_t i = 0; i < shards_.size(); ++i)
+        {
+            const Shard& shard = *shards_[i];
+
+            ShardStats shard_stats;
+            shard_stats.devices_count = actuators_count_ ? shard.actuator_states.size() / actuators_count_ : 0;
+            shard_stats.events_processed = shard.events_processed.load(std::memory_order_relaxed);
+            shard_stats.events_per_second = shard_stats.events_processed / elapsed.count();
+            shard_stats.queue_depth = shard.inbox.size_approx();
+            shard_stats.max_queue_depth = shard.max_queue_depth.load(std::memory_order_relaxed);
+            shard_stats.commands_emitted = shard.commands_emitted.load(std::memory_order_relaxed);
+            shard_stats.commands_suppressed = shard.commands_suppressed.load(std::memory_order_relaxed);
+
+            stats.push_back(shard_stats);
+        }
+
+        return stats;
+    }
+};
+
+#endif /*RULE_ENGINE_HPP_*/
@@ -1,9 +1,12 @@
 #ifndef CHAIN_HPP_
 #define CHAIN_HPP_
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 // "Handler"
 class Handler
@@ -31,6 +34,8 @@ public:
     virtual ~Handler() = default;
 private:
     std::shared_ptr<Handler> successor_;
+
+    friend class HandlerChain;
 };
 
 // "ConcreteHandler1"
@@ -78,4 +83,80 @@ public:
     }
 };
 
+// Chain of handlers kept in a vector - successors are indexes instead of pointers.
+// Dispatch is a loop and destruction just destroys the vector, so the length of
+// the chain is not limited by the size of the stack.
+class HandlerChain
+{
+public:
+    using HandlerIndex = size_t;
+    static constexpr HandlerIndex npos = static_cast<HandlerIndex>(-1);
+
+private:
+    struct Link
+    {
+        std::unique_ptr<Handler> handler;
+        HandlerIndex successor;
+    };
+
+    std::vector<Link> links_;
+    HandlerIndex head_ = npos;
+    HandlerIndex tail_ = npos;
+
+public:
+    // appends a handler at the end of the chain
+    HandlerIndex add_handler(std::unique_ptr<Handler> handler)
+    {
+        const HandlerIndex index = links_.size();
+        links_.push_back(Link{std::move(handler), npos});
+
+        if (tail_ == npos)
+            head_ = index;
+        else
+            links_[tail_].successor = index;
+        tail_ = index;
+
+        return index;
+    }
+
+    // successor has to be an index of a handler in the chain or npos (end of the chain);
+    // a link that would make a cycle is rejected - handle_request() would never finish
+    void set_successor(HandlerIndex handler, HandlerIndex successor)
+    {
+        if (handler >= links_.size())
+            throw std::out_of_range("Invalid handler index");
+
+        if (successor != npos && successor >= links_.size())
+            throw std::out_of_range("Invalid successor index");
+
+        for (HandlerIndex index = successor; index != npos; index = links_[index].successor)
+            if (index == handler)
+                throw std::invalid_argument("Successor would create a cycle in the chain");
+
+        links_[handler].successor = successor;
+    }
+
+    size_t size() const
+    {
+        return links_.size();
+    }
+
+    // returns false if no handler in the chain could handle the request
+    bool handle_request(int request) const
+    {
+        for (HandlerIndex index = head_; index != npos; index = links_[index].successor)
+        {
+            const Handler& handler = *links_[index].handler;
+
+            if (handler.can_handle_request(request))
+            {
+                handler.process_request(request);
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
 #endif /*CHAIN_HPP_*/
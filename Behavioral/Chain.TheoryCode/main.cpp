@@ -1,10 +1,72 @@
 #include "chain.hpp"
 #include <array>
+#include <chrono>
 #include <iostream>
+#include <string>
 
 using namespace std;
 
-int main()
+std::unique_ptr<Handler> create_handler(size_t index)
+{
+    switch (index % 3)
+    {
+    case 0:
+        return make_unique<ConcreteHandler1>();
+    case 1:
+        return make_unique<ConcreteHandler2>();
+    default:
+        return make_unique<ConcreteHandler3>();
+    }
+}
+
+void benchmark_long_chains(size_t handlers_count)
+{
+    constexpr int requests_count = 1'000;
+    constexpr int unhandled_request = 100; // walks through the whole chain
+
+    chrono::duration<double, micro> linked_dispatch_time{}, linked_teardown_time{};
+    {
+        shared_ptr<Handler> head = create_handler(0);
+        Handler* tail = head.get();
+        for (size_t i = 1; i < handlers_count; ++i)
+        {
+            shared_ptr<Handler> handler = create_handler(i);
+            tail->set_successor(handler);
+            tail = handler.get();
+        }
+
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < requests_count; ++i)
+            head->handle_request(unhandled_request);
+        linked_dispatch_time = chrono::steady_clock::now() - start;
+
+        start = chrono::steady_clock::now();
+        head.reset(); // recursive destruction of successors
+        linked_teardown_time = chrono::steady_clock::now() - start;
+    }
+
+    chrono::duration<double, micro> vector_dispatch_time{}, vector_teardown_time{};
+    {
+        auto chain = make_unique<HandlerChain>();
+        for (size_t i = 0; i < handlers_count; ++i)
+            chain->add_handler(create_handler(i));
+
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < requests_count; ++i)
+            chain->handle_request(unhandled_request);
+        vector_dispatch_time = chrono::steady_clock::now() - start;
+
+        start = chrono::steady_clock::now();
+        chain.reset();
+        vector_teardown_time = chrono::steady_clock::now() - start;
+    }
+
+    cout << "Chain of " << handlers_count << " handlers"
+         << " - linked: " << linked_dispatch_time.count() / requests_count << "us per request, teardown " << linked_teardown_time.count() << "us"
+         << "; vector: " << vector_dispatch_time.count() / requests_count << "us per request, teardown " << vector_teardown_time.count() << "us\n";
+}
+
+int main(int argc, char* argv[])
 {
     // Setup Chain of Responsibility
     shared_ptr<Handler> h1 = make_shared<ConcreteHandler1>();
@@ -20,4 +82,28 @@ int main()
     {
         h1->handle_request(r);
     }
+
+    // The same chain stored in a vector
+    HandlerChain chain;
+    chain.add_handler(make_unique<ConcreteHandler1>());
+    chain.add_handler(make_unique<ConcreteHandler2>());
+    chain.add_handler(make_unique<ConcreteHandler3>());
+
+    for (const auto& r : requests)
+    {
+        chain.handle_request(r);
+    }
+
+    // long chains have up to a million handlers - they are run on request only
+    if (argc < 2 || string{argv[1]} != "--benchmark")
+        return 0;
+
+    benchmark_long_chains(10'000);
+
+    // too long for the recursive dispatch & destruction of the linked chain
+    HandlerChain long_chain;
+    for (size_t i = 0; i < 1'000'000; ++i)
+        long_chain.add_handler(create_handler(i));
+
+    cout << "Chain of " << long_chain.size() << " handlers - request 100 handled: " << boolalpha << long_chain.handle_request(100) << '\n';
 }
@@ -1,15 +1,156 @@
+#include "market_data_engine.hpp"
 #include "stock.hpp"
+#include <atomic>
+#include <memory>
+#include <random>
+#include <string>
 
 using namespace std;
 
-int main()
+class TickCounter : public Observer
+{
+    size_t ticks_count_ = 0;
+
+public:
+    void update(const std::string&, double) override
+    {
+        ++ticks_count_;
+    }
+
+    size_t ticks_count() const
+    {
+        return ticks_count_;
+    }
+};
+
+void conflation_replay_benchmark()
+{
+    constexpr size_t symbols_count = 5'000;
+    constexpr size_t ticks_count = 1'000'000;
+    constexpr size_t investors_count = 10;
+
+    vector<Stock> stocks;
+    stocks.reserve(symbols_count);
+    for (size_t i = 0; i < symbols_count; ++i)
+        stocks.emplace_back("SYM" + to_string(i), 100.0);
+
+    vector<TickCounter> investors(investors_count);
+    vector<unique_ptr<ConflatingFeed>> feeds;
+    for (size_t i = 0; i < investors_count; ++i)
+    {
+        // every investor has its own throttling window: 0ms, 1ms, 2ms, ...
+        feeds.push_back(make_unique<ConflatingFeed>(investors[i], chrono::milliseconds(i)));
+        for (auto& stock : stocks)
+            stock.subscribe(feeds.back().get());
+    }
+
+    mt19937_64 rnd{665};
+    uniform_int_distribution<size_t> symbol_distr{0, symbols_count - 1};
+    uniform_real_distribution<double> price_distr{50.0, 150.0};
+
+    auto start = chrono::steady_clock::now();
+
+    for (size_t tick = 0; tick < ticks_count; ++tick)
+    {
+        stocks[symbol_distr(rnd)].set_price(price_distr(rnd));
+
+        if (tick % 10'000 == 0) // slow investors catch up from time to time
+            for (auto& feed : feeds)
+                feed->deliver_pending();
+    }
+
+    for (auto& feed : feeds)
+        feed->deliver_pending(chrono::steady_clock::now() + chrono::hours(1));
+
+    auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start);
+
+    size_t received = 0;
+    size_t delivered = 0;
+    for (auto& feed : feeds)
+    {
+        received += feed->stats().received;
+        delivered += feed->stats().delivered;
+    }
+
+    cout << "Replay of " << ticks_count << " ticks (" << symbols_count << " symbols, " << investors_count << " investors): "
+         << elapsed.count() << "s; " << ticks_count / elapsed.count() / 1e6 << "M ticks/s; "
+         << "received: " << received << "; delivered: " << delivered << " (" << 100.0 * delivered / received << "%)" << endl;
+}
+
+class AtomicTickCounter : public Observer
+{
+    std::atomic<size_t> ticks_count_{0};
+
+public:
+    void update(const std::string&, double) override
+    {
+        ticks_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    size_t ticks_count() const
+    {
+        return ticks_count_.load();
+    }
+};
+
+void fan_out_benchmark()
+{
+    constexpr size_t symbols_count = 2'000;
+    constexpr size_t investors_count = 100'000;
+    constexpr size_t subscriptions_per_investor = 2;
+    constexpr size_t batches_count = 100;
+    constexpr size_t batch_size = 1'000;
+
+    MarketDataEngine engine;
+    for (size_t i = 0; i < symbols_count; ++i)
+        engine.add_stock("SYM" + to_string(i), 100.0);
+
+    mt19937_64 rnd{42};
+    uniform_int_distribution<uint32_t> symbol_distr{0, symbols_count - 1};
+
+    vector<AtomicTickCounter> investors(investors_count);
+    for (auto& investor : investors)
+        for (size_t i = 0; i < subscriptions_per_investor; ++i)
+            engine.subscribe(symbol_distr(rnd), &investor);
+
+    TickGenerator tick_generator{symbols_count};
+
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < batches_count; ++i)
+        engine.publish(tick_generator.next_batch(batch_size));
+    auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start);
+
+    size_t notifications_count = 0;
+    for (const auto& investor : investors)
+        notifications_count += investor.ticks_count();
+
+    auto report = engine.latency_report();
+    cout << "Fan-out of " << report.ticks_count << " ticks to " << investors_count * subscriptions_per_investor << " subscriptions: "
+         << notifications_count / elapsed.count() / 1e6 << "M notifications/s; latency p50: " << report.p50.count() / 1000
+         << "us, p99: " << report.p99.count() / 1000 << "us, p99.9: " << report.p999.count() / 1000
+         << "us, max: " << report.max.count() / 1000 << "us" << endl;
+}
+
+int main(int argc, char* argv[])
 {
     Stock misys("Misys", 340.0);
     Stock ibm("IBM", 245.0);
     Stock tpsa("TPSA", 95.0);
 
     // rejestracja inwestorow zainteresowanych powiadomieniami o zmianach kursu spolek
-    // TODO:
+    Investor kulczyk_junior("Kulczyk Jr");
+    Investor solorz("Solorz");
+
+    misys.subscribe(&kulczyk_junior);
+    ibm.subscribe(&kulczyk_junior);
+    tpsa.subscribe(&solorz);
+
+    // slow investor - sees only the newest price of each stock
+    Investor soros("Soros");
+    ConflatingFeed soros_feed(soros);
+    misys.subscribe(&soros_feed);
+    ibm.subscribe(&soros_feed);
+    tpsa.subscribe(&soros_feed);
 
     // zmian kursow
     misys.set_price(360.0);
@@ -19,4 +160,16 @@ int main()
     misys.set_price(380.0);
     ibm.set_price(230.0);
     tpsa.set_price(15.0);
+
+    soros_feed.deliver_pending();
+
+    // benchmarks replay a million ticks and subscribe 100k investors - they are run on request only
+    if (argc < 2 || string{argv[1]} != "--benchmark")
+        return 0;
+
+    cout << "\n";
+
+    conflation_replay_benchmark();
+
+    fan_out_benchmark();
 }
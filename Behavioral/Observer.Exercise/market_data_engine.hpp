@@ -0,0 +1,290 @@
+#ifndef MARKET_DATA_ENGINE_HPP_
+#define MARKET_DATA_ENGINE_HPP_
+
+#include "stock.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct Tick
+{
+    using Clock = std::chrono::steady_clock;
+
+    uint32_t symbol_index;
+    double price;
+    Clock::time_point timestamp;
+};
+
+struct LatencyReport
+{
+    size_t ticks_count = 0;
+    std::chrono::nanoseconds p50{};
+    std::chrono::nanoseconds p99{};
+    std::chrono::nanoseconds p999{};
+    std::chrono::nanoseconds max{};
+};
+
+// Fixed-size histogram of latencies with log-linear buckets: every power of two is split into
+// 16 linear sub-buckets, so a reported percentile is at most 1/16 above the real value.
+// Memory does not depend on the number of recorded samples.
+class LatencyHistogram
+{
+    static constexpr unsigned sub_bucket_bits = 4;
+    static constexpr uint64_t sub_buckets_count = uint64_t{1} << sub_bucket_bits;
+    static constexpr size_t buckets_count = (64 - sub_bucket_bits + 1) * sub_buckets_count;
+
+    std::array<uint64_t, buckets_count> counts_{};
+    uint64_t total_count_ = 0;
+    uint64_t max_ = 0;
+
+    static size_t bucket_index(uint64_t value)
+    {
+        if (value < sub_buckets_count)
+            return static_cast<size_t>(value);
+
+        const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - 1 - sub_bucket_bits;
+        return (shift + 1) * sub_buckets_count + static_cast<size_t>((value >> shift) & (sub_buckets_count - 1));
+    }
+
+    // the largest value that falls into the bucket
+    static uint64_t bucket_upper_bound(size_t index)
+    {
+        if (index < sub_buckets_count)
+            return index;
+
+        const unsigned shift = static_cast<unsigned>(index / sub_buckets_count) - 1;
+        const uint64_t sub_bucket = sub_buckets_count + index % sub_buckets_count;
+        return ((sub_bucket + 1) << shift) - 1;
+    }
+
+public:
+    void record(std::chrono::nanoseconds latency)
+    {
+        const auto value = static_cast<uint64_t>(std::max<std::chrono::nanoseconds::rep>(latency.count(), 0));
+
+        ++counts_[bucket_index(value)];
+        ++total_count_;
+        max_ = std::max(max_, value);
+    }
+
+    void merge(const LatencyHistogram& other)
+    {
+        for (size_t i = 0; i < buckets_count; ++i)
+            counts_[i] += other.counts_[i];
+
+        total_count_ += other.total_count_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    uint64_t count() const
+    {
+        return total_count_;
+    }
+
+    std::chrono::nanoseconds max() const
+    {
+        return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(max_)};
+    }
+
+    // p in [0, 1]; returns 0 for an empty histogram
+    std::chrono::nanoseconds percentile(double p) const
+    {
+        if (total_count_ == 0)
+            return std::chrono::nanoseconds{0};
+
+        const auto rank = static_cast<uint64_t>(p * static_cast<double>(total_count_ - 1)); // 0-based, as nth_element
+        uint64_t cumulative_count = 0;
+
+        for (size_t i = 0; i < buckets_count; ++i)
+        {
+            cumulative_count += counts_[i];
+            if (cumulative_count > rank)
+                return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(std::min(bucket_upper_bound(i), max_))};
+        }
+
+        return max();
+    }
+};
+
+// Fan-out engine for market data.
+// Every Stock keeps its subscribers in a contiguous array. Stocks are partitioned into shards by symbol;
+// each shard has its own worker thread, so a Stock is only ever touched by one thread.
+// An observer subscribed to stocks from different shards may be notified concurrently - it has to be thread-safe.
+// All stocks have to be added before the first batch is published.
+class MarketDataEngine
+{
+    struct Shard
+    {
+        std::vector<Tick> ticks;
+        LatencyHistogram latencies;
+        std::thread worker;
+    };
+
+    std::vector<Stock> stocks_;
+    std::unordered_map<std::string, uint32_t> symbol_indexes_;
+    std::vector<Shard> shards_;
+
+    std::mutex mtx_;
+    std::condition_variable batch_ready_;
+    std::condition_variable batch_done_;
+    size_t batch_generation_ = 0;
+    size_t pending_shards_ = 0;
+    bool is_stopped_ = false;
+
+    void run_shard(Shard& shard)
+    {
+        size_t processed_generation = 0;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lk{mtx_};
+                batch_ready_.wait(lk, [&] { return is_stopped_ || batch_generation_ != processed_generation; });
+
+                if (is_stopped_)
+                    return;
+
+                processed_generation = batch_generation_;
+            }
+
+            for (const auto& tick : shard.ticks)
+            {
+                stocks_[tick.symbol_index].set_price(tick.price);
+                shard.latencies.record(Tick::Clock::now() - tick.timestamp);
+            }
+
+            {
+                std::lock_guard<std::mutex> lk{mtx_};
+                if (--pending_shards_ == 0)
+                    batch_done_.notify_one();
+            }
+        }
+    }
+
+public:
+    explicit MarketDataEngine(size_t shards_count = std::max(1u, std::thread::hardware_concurrency()))
+        : shards_(std::max<size_t>(shards_count, 1))
+    {
+        for (auto& shard : shards_)
+            shard.worker = std::thread{[this, &shard] { run_shard(shard); }};
+    }
+
+    MarketDataEngine(const MarketDataEngine&) = delete;
+    MarketDataEngine& operator=(const MarketDataEngine&) = delete;
+
+    ~MarketDataEngine()
+    {
+        {
+            std::lock_guard<std::mutex> lk{mtx_};
+            is_stopped_ = true;
+        }
+        batch_ready_.notify_all();
+
+        for (auto& shard : shards_)
+            shard.worker.join();
+    }
+
+    uint32_t add_stock(const std::string& symbol, double price)
+    {
+        auto [pos, is_inserted] = symbol_indexes_.try_emplace(symbol, static_cast<uint32_t>(stocks_.size()));
+        if (is_inserted)
+            stocks_.emplace_back(symbol, price);
+
+        return pos->second;
+    }
+
+    uint32_t symbol_index(const std::string& symbol) const
+    {
+        return symbol_indexes_.at(symbol);
+    }
+
+    size_t stocks_count() const
+    {
+        return stocks_.size();
+    }
+
+    void subscribe(uint32_t symbol_index, Observer* observer)
+    {
+        stocks_.at(symbol_index).subscribe(observer);
+    }
+
+    // splits the batch by shard and blocks until all ticks are delivered
+    void publish(const std::vector<Tick>& batch)
+    {
+        for (auto& shard : shards_)
+            shard.ticks.clear();
+
+        for (const auto& tick : batch)
+            shards_[tick.symbol_index % shards_.size()].ticks.push_back(tick);
+
+        std::unique_lock<std::mutex> lk{mtx_};
+        pending_shards_ = shards_.size();
+        ++batch_generation_;
+        batch_ready_.notify_all();
+
+        batch_done_.wait(lk, [this] { return pending_shards_ == 0; });
+    }
+
+    // latency from tick creation until all subscribers of the stock were notified
+    LatencyReport latency_report() const
+    {
+        LatencyHistogram latencies;
+        for (const auto& shard : shards_)
+            latencies.merge(shard.latencies);
+
+        LatencyReport report;
+        report.ticks_count = latencies.count();
+        report.p50 = latencies.percentile(0.5);
+        report.p99 = latencies.percentile(0.99);
+        report.p999 = latencies.percentile(0.999);
+        report.max = latencies.max();
+
+        return report;
+    }
+};
+
+// Synthetic ticks: random symbols with random-walk prices
+class TickGenerator
+{
+    std::mt19937_64 rnd_;
+    std::uniform_int_distribution<uint32_t> symbol_distr_;
+    std::normal_distribution<double> price_change_distr_{0.0, 0.5};
+    std::vector<double> prices_;
+
+public:
+    TickGenerator(size_t symbols_count, uint64_t seed = 665)
+        : rnd_{seed}
+        , symbol_distr_{0, static_cast<uint32_t>(symbols_count - 1)}
+        , prices_(symbols_count, 100.0)
+    {
+    }
+
+    std::vector<Tick> next_batch(size_t batch_size)
+    {
+        std::vector<Tick> batch;
+        batch.reserve(batch_size);
+
+        for (size_t i = 0; i < batch_size; ++i)
+        {
+            auto symbol_index = symbol_distr_(rnd_);
+            auto& price = prices_[symbol_index];
+            price = std::max(0.01, price + price_change_distr_(rnd_));
+
+            batch.push_back(Tick{symbol_index, price, Tick::Clock::now()});
+        }
+
+        return batch;
+    }
+};
+
+#endif /*MARKET_DATA_ENGINE_HPP_*/
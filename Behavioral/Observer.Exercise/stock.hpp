@@ -1,13 +1,20 @@
 #ifndef STOCK_HPP_
 #define STOCK_HPP_
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 class Observer
 {
 public:
-    virtual void update(/*...*/) = 0;
+    virtual void update(const std::string& symbol, double price) = 0;
     virtual ~Observer()
     {
     }
@@ -19,7 +26,8 @@ class Stock
 private:
     std::string symbol_;
     double price_;
-    // TODO - kontener przechowywujacy obserwatorow
+    std::vector<Observer*> observers_;
+
 public:
     Stock(const std::string& symbol, double price) : symbol_(symbol), price_(price)
     {
@@ -35,15 +43,23 @@ public:
         return price_;
     }
 
-    // TODO: rejestracja obserwatora
+    void subscribe(Observer* observer)
+    {
+        if (std::find(observers_.begin(), observers_.end(), observer) == observers_.end())
+            observers_.push_back(observer);
+    }
 
-    // TODO: wyrejestrowanie obserwatora
+    void unsubscribe(Observer* observer)
+    {
+        observers_.erase(std::remove(observers_.begin(), observers_.end(), observer), observers_.end());
+    }
 
     void set_price(double price)
     {
         price_ = price;
 
-        // TODO: powiadomienie inwestorow o zmianie kursu...
+        for (auto* observer : observers_)
+            observer->update(symbol_, price_);
     }
 };
 
@@ -56,9 +72,122 @@ public:
     {
     }
 
-    void update(/*...*/)
+    void update(const std::string& symbol, double price) override
+    {
+        std::cout << name_ << " notified - " << symbol << ": " << price << std::endl;
+    }
+};
+
+// Conflating proxy for a slow observer.
+// Stock notifications only overwrite a per-symbol latest-value slot (no call to the observer).
+// The observer pulls pending prices with deliver_pending() and sees only the newest price per symbol -
+// never a backlog. A throttling window limits how often deliveries happen.
+class ConflatingFeed : public Observer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats
+    {
+        size_t received = 0;
+        size_t delivered = 0;
+
+        size_t conflated() const
+        {
+            return received - delivered;
+        }
+    };
+
+private:
+    struct Slot
+    {
+        double price;
+        bool is_pending;
+    };
+
+    // pending price with a pointer to its symbol - delivered without copying the string
+    struct Delivery
+    {
+        const std::string* symbol;
+        double price;
+    };
+
+    Observer& observer_;
+    Clock::duration throttle_window_;
+    Clock::time_point last_delivery_{};
+    std::deque<std::string> symbols_;                           // addresses stay valid when symbols are added
+    std::unordered_map<std::string_view, size_t> slot_indexes_; // keys view symbols_
+    std::vector<Slot> slots_;                                   // slots_[i] belongs to symbols_[i]
+    std::vector<size_t> pending_slots_;                         // in order of first update since the last delivery
+    std::vector<Delivery> deliveries_;                          // reused buffer - observer is called outside the lock
+    Stats stats_;
+    std::mutex mtx_;
+
+public:
+    ConflatingFeed(Observer& observer, Clock::duration throttle_window = Clock::duration::zero())
+        : observer_{observer}
+        , throttle_window_{throttle_window}
+    {
+    }
+
+    void update(const std::string& symbol, double price) override
+    {
+        std::lock_guard<std::mutex> lk{mtx_};
+
+        ++stats_.received;
+
+        auto pos = slot_indexes_.find(symbol);
+        if (pos == slot_indexes_.end())
+        {
+            symbols_.push_back(symbol);
+            pos = slot_indexes_.emplace(symbols_.back(), slots_.size()).first;
+            slots_.push_back(Slot{price, false});
+        }
+
+        const size_t index = pos->second;
+        auto& slot = slots_[index];
+        slot.price = price;
+
+        if (!slot.is_pending)
+        {
+            slot.is_pending = true;
+            pending_slots_.push_back(index);
+        }
+    }
+
+    // delivers the latest price of every updated symbol; returns number of delivered prices
+    // should be called by a single consumer thread
+    size_t deliver_pending(Clock::time_point now = Clock::now())
+    {
+        {
+            std::lock_guard<std::mutex> lk{mtx_};
+
+            if (pending_slots_.empty() || now - last_delivery_ < throttle_window_)
+                return 0;
+
+            last_delivery_ = now;
+
+            deliveries_.clear();
+            for (auto index : pending_slots_)
+            {
+                slots_[index].is_pending = false;
+                deliveries_.push_back(Delivery{&symbols_[index], slots_[index].price});
+            }
+            pending_slots_.clear();
+
+            stats_.delivered += deliveries_.size();
+        }
+
+        for (const auto& delivery : deliveries_)
+            observer_.update(*delivery.symbol, delivery.price);
+
+        return deliveries_.size();
+    }
+
+    Stats stats()
     {
-        // TODO: implementacja
+        std::lock_guard<std::mutex> lk{mtx_};
+        return stats_;
     }
 };
 
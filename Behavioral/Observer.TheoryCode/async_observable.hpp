@@ -0,0 +1,331 @@
+#ifndef ASYNC_OBSERVABLE_HPP_
+#define ASYNC_OBSERVABLE_HPP_
+
+#include "observer.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Executors - decide on which thread observers are notified
+class Executor
+{
+public:
+    virtual void post(std::function<void()> task) = 0;
+    virtual ~Executor() = default;
+};
+
+// runs tasks on the publisher's thread
+class InlineExecutor : public Executor
+{
+public:
+    void post(std::function<void()> task) override
+    {
+        task();
+    }
+};
+
+// runs tasks on a pool of worker threads; queued tasks are finished before destruction
+class ThreadPoolExecutor : public Executor
+{
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    bool is_stopped_ = false;
+    std::vector<std::thread> workers_;
+
+    void run()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lk{mtx_};
+                cv_.wait(lk, [this] { return is_stopped_ || !tasks_.empty(); });
+
+                if (tasks_.empty())
+                    return;
+
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+
+            task();
+        }
+    }
+
+public:
+    explicit ThreadPoolExecutor(size_t threads_count = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        for (size_t i = 0; i < threads_count; ++i)
+            workers_.emplace_back([this] { run(); });
+    }
+
+    ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+    ~ThreadPoolExecutor() override
+    {
+        {
+            std::lock_guard<std::mutex> lk{mtx_};
+            is_stopped_ = true;
+        }
+        cv_.notify_all();
+
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+    void post(std::function<void()> task) override
+    {
+        {
+            std::lock_guard<std::mutex> lk{mtx_};
+            tasks_.push_back(std::move(task));
+        }
+        cv_.notify_one();
+    }
+};
+
+// a thread owned by a single subscriber
+class DedicatedThreadExecutor : public ThreadPoolExecutor
+{
+public:
+    DedicatedThreadExecutor()
+        : ThreadPoolExecutor{1}
+    {
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+// What happens when an observer's queue is full
+enum class BackpressurePolicy
+{
+    block,          // publisher waits for a free slot
+    drop_oldest,    // the oldest pending event is discarded
+    coalesce_latest // pending events are replaced by the newest one - at most one event is waiting
+};
+
+// Bounded multi-producer/single-consumer queue of events for one subscription.
+// At most one consumer drains the queue at a time - push() reports when a drain has to be scheduled.
+template <typename TEvent>
+class BoundedEventQueue
+{
+    std::deque<TEvent> events_;
+    const size_t capacity_;
+    const BackpressurePolicy policy_;
+    size_t dropped_count_ = 0;
+    bool is_draining_ = false;   // a drain is scheduled or running
+    bool is_consuming_ = false;  // an event popped by the consumer is being handled right now
+    bool is_closed_ = false;
+    std::thread::id consumer_id_; // valid only while is_consuming_
+    mutable std::mutex mtx_;
+    std::condition_variable state_changed_;
+
+public:
+    BoundedEventQueue(size_t capacity, BackpressurePolicy policy)
+        : capacity_{std::max<size_t>(capacity, 1)}
+        , policy_{policy}
+    {
+    }
+
+    // returns true if the caller has to schedule draining of the queue
+    bool push(TEvent event)
+    {
+        std::unique_lock<std::mutex> lk{mtx_};
+
+        switch (policy_)
+        {
+        case BackpressurePolicy::block:
+            state_changed_.wait(lk, [this] { return is_closed_ || events_.size() < capacity_; });
+            break;
+        case BackpressurePolicy::drop_oldest:
+            if (events_.size() == capacity_)
+            {
+                events_.pop_front();
+                ++dropped_count_;
+            }
+            break;
+        case BackpressurePolicy::coalesce_latest:
+            dropped_count_ += events_.size();
+            events_.clear();
+            break;
+        }
+
+        if (is_closed_)
+            return false;
+
+        events_.push_back(std::move(event));
+
+        if (is_draining_)
+            return false;
+
+        is_draining_ = true;
+        return true;
+    }
+
+    // returns std::nullopt when the queue is empty - draining is finished then
+    std::optional<TEvent> pop()
+    {
+        std::lock_guard<std::mutex> lk{mtx_};
+
+        if (events_.empty() || is_closed_)
+        {
+            events_.clear();
+            is_draining_ = false;
+            is_consuming_ = false;
+            consumer_id_ = std::thread::id{};
+            state_changed_.notify_all();
+            return std::nullopt;
+        }
+
+        std::optional<TEvent> event{std::move(events_.front())};
+        events_.pop_front();
+        is_consuming_ = true;
+        consumer_id_ = std::this_thread::get_id();
+        state_changed_.notify_all();
+
+        return event;
+    }
+
+    // Discards pending events and waits until an event being handled on another thread is finished.
+    // Does not wait when called by the consumer itself (an observer unsubscribing in update()),
+    // nor for a drain that is only scheduled - it may be queued behind the caller on the same executor
+    // and will find the queue closed when it runs.
+    void close()
+    {
+        std::unique_lock<std::mutex> lk{mtx_};
+        is_closed_ = true;
+        state_changed_.notify_all();
+
+        if (is_consuming_ && consumer_id_ == std::this_thread::get_id())
+            return;
+
+        state_changed_.wait(lk, [this] { return !is_consuming_; });
+    }
+
+    size_t dropped_count() const
+    {
+        std::lock_guard<std::mutex> lk{mtx_};
+        return dropped_count_;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Observable that delivers events through per-subscription bounded queues.
+// Every subscription names an executor - the publisher only enqueues events, so its latency
+// does not depend on the cost of Observer::update(). Events for one observer are delivered in order.
+template <typename TSource, typename... TEventArgs>
+class AsyncObservable
+{
+    using ObserverType = Observer<TSource, TEventArgs...>;
+    using Event = std::tuple<std::decay_t<TEventArgs>...>;
+
+    struct Subscription : std::enable_shared_from_this<Subscription>
+    {
+        ObserverType* observer;
+        TSource* source;
+        Executor& executor;
+        BoundedEventQueue<Event> events;
+
+        Subscription(ObserverType* observer, TSource* source, Executor& executor, size_t capacity, BackpressurePolicy policy)
+            : observer{observer}
+            , source{source}
+            , executor{executor}
+            , events{capacity, policy}
+        {
+        }
+
+        void deliver(Event event)
+        {
+            if (events.push(std::move(event)))
+                executor.post([self = this->shared_from_this()] { self->drain(); });
+        }
+
+        void drain()
+        {
+            while (auto event = events.pop())
+                std::apply([this](auto&... args) { observer->update(*source, args...); }, *event);
+        }
+    };
+
+    using Subscriptions = std::vector<std::shared_ptr<Subscription>>;
+
+    std::shared_ptr<const Subscriptions> subscriptions_ = std::make_shared<const Subscriptions>();
+    mutable std::mutex mtx_;
+
+    std::shared_ptr<const Subscriptions> subscriptions() const
+    {
+        std::lock_guard<std::mutex> lk{mtx_};
+        return subscriptions_;
+    }
+
+public:
+    AsyncObservable() = default;
+    AsyncObservable(const AsyncObservable&) = delete;
+    AsyncObservable& operator=(const AsyncObservable&) = delete;
+
+    ~AsyncObservable()
+    {
+        for (auto& subscription : *subscriptions())
+            subscription->events.close();
+    }
+
+    void subscribe(ObserverType* observer, Executor& executor,
+        BackpressurePolicy policy = BackpressurePolicy::block, size_t queue_capacity = 1024)
+    {
+        auto subscription = std::make_shared<Subscription>(observer, static_cast<TSource*>(this), executor, queue_capacity, policy);
+
+        std::lock_guard<std::mutex> lk{mtx_};
+        auto subscriptions = std::make_shared<Subscriptions>(*subscriptions_);
+        subscriptions->push_back(std::move(subscription));
+        subscriptions_ = std::move(subscriptions);
+    }
+
+    // pending events for the observer are discarded; waits for update() in progress to finish
+    void unsubscribe(ObserverType* observer)
+    {
+        std::shared_ptr<Subscription> removed;
+        {
+            std::lock_guard<std::mutex> lk{mtx_};
+
+            auto subscriptions = std::make_shared<Subscriptions>(*subscriptions_);
+            auto pos = std::find_if(subscriptions->begin(), subscriptions->end(), [observer](const auto& s) { return s->observer == observer; });
+            if (pos == subscriptions->end())
+                return;
+
+            removed = *pos;
+            subscriptions->erase(pos);
+            subscriptions_ = std::move(subscriptions);
+        }
+
+        removed->events.close();
+    }
+
+    size_t dropped_count(ObserverType* observer) const
+    {
+        for (const auto& subscription : *subscriptions())
+            if (subscription->observer == observer)
+                return subscription->events.dropped_count();
+        return 0;
+    }
+
+protected:
+    void notify(TSource&, EventParam<TEventArgs>... args)
+    {
+        auto subscriptions = this->subscriptions();
+
+        for (const auto& subscription : *subscriptions)
+            subscription->deliver(Event{args...});
+    }
+};
+
+#endif /*ASYNC_OBSERVABLE_HPP_*/
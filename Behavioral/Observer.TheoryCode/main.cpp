@@ -1,5 +1,15 @@
+#include "async_observable.hpp"
 #include "observer.hpp"
+#include "signal.hpp"
+#include <atomic>
 #include <boost/signals2.hpp>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
@@ -171,7 +181,412 @@ void boost_observer()
     temp_monitor.set_temperature(21.0);
 }
 
-int main()
+namespace SignalObserver
+{
+    // the same API as BoostObserver - slots are stored inline, emission does not lock nor allocate
+    class TemperatureMonitor
+    {
+        using TemperatureChanged = Signal<void(double)>;
+
+        TemperatureChanged temperature_changed_;
+        double current_temperature_;
+    public:
+        TemperatureMonitor(double temp)
+            : current_temperature_{temp}
+        {
+        }
+
+        void set_temperature(double new_temperature)
+        {
+            if (current_temperature_ != new_temperature)
+            {
+                current_temperature_ = new_temperature;
+                temperature_changed_(current_temperature_); // notify all subscribers
+            }
+        }
+
+        template <typename TSlot>
+        TemperatureChanged::Connection subscribe(TSlot&& slot)
+        {
+            return temperature_changed_.subscribe(std::forward<TSlot>(slot)); // register a new subscriber
+        }
+    };
+
+    class Fan
+    {
+        using FanStateChanged = Signal<void(const std::string&)>;
+
+        bool is_on_ = false;
+        FanStateChanged fan_state_changed_;
+    public:
+        Fan() = default;
+
+        void on_temp_changed(double current_temperature)
+        {
+            if (!is_on_ && current_temperature > 25.0)
+                on();
+
+            if (is_on_ && current_temperature < 24.0)
+                off();
+        }
+
+        void on()
+        {
+            is_on_ = true;
+            fan_state_changed_("Fan is on...");
+        }
+
+        void off()
+        {
+            is_on_ = false;
+            fan_state_changed_("Fan is off...");
+        }
+
+        template <typename TSlot>
+        FanStateChanged::Connection subscribe(TSlot&& slot)
+        {
+            return fan_state_changed_.subscribe(std::forward<TSlot>(slot));
+        }
+    };
+}
+
+void signal_observer()
+{
+    SignalObserver::Fan fan;
+    SignalObserver::TemperatureMonitor temp_monitor(21.0);
+    BoostObserver::ConsoleLogger console_logger;
+
+    temp_monitor.subscribe([&console_logger](double temp) { console_logger.log_temperature(temp); });
+    auto conn = temp_monitor.subscribe([&fan](double temp) { fan.on_temp_changed(temp); });
+    fan.subscribe([&console_logger](const std::string& message) { console_logger.log_fan_state(message); });
+
+    temp_monitor.set_temperature(22.0);
+    temp_monitor.set_temperature(26.0);
+
+    conn.disconnect();
+
+    temp_monitor.set_temperature(21.0);
+}
+
+template <typename TSignal, typename TConnect>
+void benchmark_signal_emission(const string& name, size_t slots_count, TConnect connect)
+{
+    constexpr int emissions_count = 1'000'000;
+
+    TSignal signal;
+    vector<double> sums(slots_count);
+    for (auto& sum : sums)
+        connect(signal, [&sum](double value) { sum += value; });
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < emissions_count; ++i)
+        signal(i);
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+
+    cout << name << " - " << slots_count << " slots: " << elapsed.count() / emissions_count << "ns per emission"
+         << " (checksum: " << accumulate(sums.begin(), sums.end(), 0.0) << ")" << endl;
+}
+
+void benchmark_signals()
+{
+    auto connect_boost = [](auto& signal, auto slot) { signal.connect(slot); };
+    auto subscribe = [](auto& signal, auto slot) { signal.subscribe(slot); };
+
+    for (size_t slots_count : {1u, 4u, 16u})
+    {
+        benchmark_signal_emission<boost::signals2::signal<void(double)>>("boost::signals2::signal", slots_count, connect_boost);
+        benchmark_signal_emission<Signal<void(double)>>("Signal<single-threaded>", slots_count, subscribe);
+        benchmark_signal_emission<Signal<void(double), SignalThreading::MultiThreaded>>("Signal<multi-threaded>", slots_count, subscribe);
+    }
+}
+
+namespace Concurrent
+{
+    class PriceFeed : public ConcurrentObservable<PriceFeed, double>
+    {
+    public:
+        void publish_price(double price)
+        {
+            notify(*this, price);
+        }
+    };
+
+    class PriceCounter : public Observer<PriceFeed, double>
+    {
+    public:
+        inline static thread_local size_t updates_count = 0;
+
+        void update(PriceFeed&, double) override
+        {
+            ++updates_count;
+        }
+    };
+}
+
+void benchmark_concurrent_observable(unsigned publishers_count, size_t observers_count)
+{
+    using namespace Concurrent;
+    using namespace std::literals;
+
+    constexpr size_t prices_per_publisher = 200'000;
+
+    PriceFeed feed;
+    vector<unique_ptr<PriceCounter>> counters;
+    for (size_t i = 0; i < observers_count; ++i)
+    {
+        counters.push_back(make_unique<PriceCounter>());
+        feed.subscribe(counters.back().get());
+    }
+
+    atomic<bool> is_running{true};
+    atomic<size_t> total_updates{0};
+
+    // subscriptions change while notifications are in flight
+    PriceCounter churning_counter;
+    thread churn_thread{[&] {
+        while (is_running.load())
+        {
+            feed.subscribe(&churning_counter);
+            feed.unsubscribe(&churning_counter);
+            this_thread::sleep_for(1ms);
+        }
+    }};
+
+    auto start = chrono::steady_clock::now();
+
+    vector<thread> publishers;
+    for (unsigned p = 0; p < publishers_count; ++p)
+        publishers.emplace_back([&feed, &total_updates] {
+            for (size_t i = 0; i < prices_per_publisher; ++i)
+                feed.publish_price(static_cast<double>(i));
+            total_updates += PriceCounter::updates_count;
+        });
+
+    for (auto& thd : publishers)
+        thd.join();
+
+    auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start);
+
+    is_running = false;
+    churn_thread.join();
+
+    cout << "ConcurrentObservable - publishers: " << publishers_count << ", observers: " << observers_count
+         << " -> " << total_updates / elapsed.count() / 1e6 << "M notifications/s" << endl;
+}
+
+namespace Async
+{
+    class TemperatureMonitor : public AsyncObservable<TemperatureMonitor, double>
+    {
+        double current_temperature_;
+
+    public:
+        TemperatureMonitor(double temp)
+            : current_temperature_{temp}
+        {
+        }
+
+        void set_temperature(double new_temperature)
+        {
+            if (current_temperature_ != new_temperature)
+            {
+                current_temperature_ = new_temperature;
+                notify(*this, current_temperature_);
+            }
+        }
+    };
+
+    class SlowLogger : public Observer<TemperatureMonitor, double>
+    {
+        atomic<size_t> updates_count_{0};
+
+    public:
+        void update(TemperatureMonitor&, double) override
+        {
+            this_thread::sleep_for(chrono::microseconds(50));
+            ++updates_count_;
+        }
+
+        size_t updates_count() const
+        {
+            return updates_count_;
+        }
+    };
+}
+
+namespace Payloads
+{
+    // large event payload - counts how many times it was copied
+    struct Frame
+    {
+        inline static size_t copies_count = 0;
+
+        std::vector<double> samples;
+
+        explicit Frame(size_t samples_count)
+            : samples(samples_count, 1.0)
+        {
+        }
+
+        Frame(const Frame& other)
+            : samples{other.samples}
+        {
+            ++copies_count;
+        }
+
+        Frame& operator=(const Frame& other)
+        {
+            samples = other.samples;
+            ++copies_count;
+            return *this;
+        }
+
+        Frame(Frame&&) = default;
+        Frame& operator=(Frame&&) = default;
+    };
+
+    class Camera : public Observable<Camera, Frame>
+    {
+    public:
+        void publish(const Frame& frame)
+        {
+            notify(*this, frame);
+        }
+    };
+
+    class FrameAnalyzer : public Observer<Camera, Frame>
+    {
+        double total_ = 0.0;
+
+    public:
+        void update(Camera&, const Frame& frame) override
+        {
+            total_ += frame.samples.front() + frame.samples.back();
+        }
+
+        double total() const
+        {
+            return total_;
+        }
+    };
+
+    class Sensor : public Observable<Sensor, double>
+    {
+    public:
+        void publish(double sample)
+        {
+            notify(*this, sample);
+        }
+
+        void publish(std::span<const double> samples)
+        {
+            notify_batch(*this, samples);
+        }
+    };
+
+    class SampleAccumulator : public Observer<Sensor, double>
+    {
+        double sum_ = 0.0;
+
+    public:
+        void update(Sensor&, double sample) override
+        {
+            sum_ += sample;
+        }
+
+        void update_batch(Sensor&, std::span<const double> samples) override
+        {
+            for (auto sample : samples)
+                sum_ += sample;
+        }
+
+        double sum() const
+        {
+            return sum_;
+        }
+    };
+}
+
+void benchmark_large_payload(size_t observers_count)
+{
+    using namespace Payloads;
+
+    constexpr int frames_count = 10'000;
+    constexpr size_t samples_per_frame = 64 * 1024; // 512KB per frame
+
+    Camera camera;
+    vector<FrameAnalyzer> analyzers(observers_count);
+    for (auto& analyzer : analyzers)
+        camera.subscribe(&analyzer);
+
+    Frame frame{samples_per_frame};
+    Frame::copies_count = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < frames_count; ++i)
+        camera.publish(frame);
+    chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - start;
+
+    cout << "Large payload - observers: " << observers_count << " -> " << elapsed.count() / frames_count << "us per notify"
+         << ", payload copies: " << Frame::copies_count << endl;
+}
+
+void benchmark_batched_notify(size_t observers_count, size_t batch_size)
+{
+    using namespace Payloads;
+
+    constexpr size_t samples_count = 1'000'000;
+
+    vector<double> samples(samples_count);
+    iota(samples.begin(), samples.end(), 0.0);
+
+    Sensor sensor;
+    vector<SampleAccumulator> accumulators(observers_count);
+    for (auto& accumulator : accumulators)
+        sensor.subscribe(&accumulator);
+
+    auto start = chrono::steady_clock::now();
+    if (batch_size == 1)
+    {
+        for (auto sample : samples)
+            sensor.publish(sample);
+    }
+    else
+    {
+        for (size_t offset = 0; offset < samples_count; offset += batch_size)
+            sensor.publish(std::span<const double>{samples}.subspan(offset, min(batch_size, samples_count - offset)));
+    }
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+
+    cout << "Batched notify - observers: " << observers_count << ", batch size: " << batch_size << " -> "
+         << elapsed.count() / samples_count << "ns per sample (checksum: " << accumulators.front().sum() << ")" << endl;
+}
+
+void benchmark_async_dispatch(const string& name, Executor& executor, BackpressurePolicy policy, size_t queue_capacity)
+{
+    constexpr int temperatures_count = 2'000;
+
+    Async::SlowLogger logger;
+    size_t dropped_count = 0;
+    chrono::duration<double, micro> publisher_time{};
+    {
+        Async::TemperatureMonitor temp_monitor{0.0};
+        temp_monitor.subscribe(&logger, executor, policy, queue_capacity);
+
+        auto start = chrono::steady_clock::now();
+        for (int i = 1; i <= temperatures_count; ++i)
+            temp_monitor.set_temperature(i);
+        publisher_time = chrono::steady_clock::now() - start;
+
+        this_thread::sleep_for(chrono::milliseconds(100));
+        dropped_count = temp_monitor.dropped_count(&logger);
+    } // pending events are discarded
+
+    cout << name << " - publisher: " << publisher_time.count() / temperatures_count << "us per set_temperature()"
+         << "; delivered: " << logger.updates_count() << "; dropped: " << dropped_count << endl;
+}
+
+int main(int argc, char* argv[])
 {
     // Fan fan;
     // TemperatureMonitor temp_monitor(21.0);
@@ -204,4 +619,30 @@ int main()
     // temp_monitor.set_temperature(21.0);
 
     boost_observer();
+    signal_observer();
+
+    // benchmarks run for several seconds and start many threads - they are run on request only
+    if (argc < 2 || string{argv[1]} != "--benchmark")
+        return 0;
+
+    benchmark_signals();
+
+    InlineExecutor inline_executor;
+    DedicatedThreadExecutor dedicated_executor;
+    ThreadPoolExecutor pool_executor{4};
+
+    benchmark_async_dispatch("inline", inline_executor, BackpressurePolicy::block, 1024);
+    benchmark_async_dispatch("dedicated thread, block", dedicated_executor, BackpressurePolicy::block, 4096);
+    benchmark_async_dispatch("thread pool, drop oldest", pool_executor, BackpressurePolicy::drop_oldest, 64);
+    benchmark_async_dispatch("thread pool, coalesce latest", pool_executor, BackpressurePolicy::coalesce_latest, 1);
+
+    for (size_t observers_count : {1u, 8u})
+        benchmark_large_payload(observers_count);
+
+    for (size_t batch_size : {1u, 64u, 1024u})
+        benchmark_batched_notify(8, batch_size);
+
+    for (unsigned publishers_count : {1u, 2u, 4u})
+        for (size_t observers_count : {1u, 16u, 128u})
+            benchmark_concurrent_observable(publishers_count, observers_count);
 }
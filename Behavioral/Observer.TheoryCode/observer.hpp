@@ -1,16 +1,65 @@
 #ifndef OBSERVER_HPP_
 #define OBSERVER_HPP_
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <span>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Scalars are passed by value, everything else by const reference -
+// the same event object is shared by all observers and never copied or moved from
+template <typename T>
+using EventParam = std::conditional_t<std::is_scalar_v<std::decay_t<T>>, std::decay_t<T>, const std::decay_t<T>&>;
+
+// Event stored in a batch: the single argument itself or a tuple of arguments
+template <typename... TEventArgs>
+struct EventTypeTraits
+{
+    using type = std::tuple<std::decay_t<TEventArgs>...>;
+};
+
+template <typename TEventArg>
+struct EventTypeTraits<TEventArg>
+{
+    using type = std::decay_t<TEventArg>;
+};
+
+template <typename... TEventArgs>
+using EventType = typename EventTypeTraits<TEventArgs...>::type;
 
 //////////////////////////////////////////////////////////////////////////////////////
 template <typename TSource, typename... TEventArgs>
 class Observer
 {
 public:
-    virtual void update(TSource&, TEventArgs... args) = 0;
+    using Event = EventType<TEventArgs...>;
+
+    // Non-scalar arguments are received as const references - overrides declared with by-value
+    // class types (e.g. update(Source&, std::string)) must be changed to const T&
+    virtual void update(TSource&, EventParam<TEventArgs>... args) = 0;
+
+    // default: one update() per event - override to handle the whole batch in a single call
+    virtual void update_batch(TSource& source, std::span<const Event> events)
+    {
+        for (const auto& event : events)
+        {
+            if constexpr (sizeof...(TEventArgs) == 1)
+                update(source, event);
+            else
+                std::apply([&](const auto&... args) { update(source, args...); }, event);
+        }
+    }
+
     virtual ~Observer() = default;
 };
 
@@ -18,6 +67,8 @@ public:
 template <typename TSource, typename... TEventArgs>
 struct Observable
 {
+    using Event = EventType<TEventArgs...>;
+
     void subscribe(Observer<TSource, TEventArgs...>* observer)
     {        
         observers_.insert(observer);
@@ -26,14 +77,168 @@ struct Observable
     void unsubscribe(Observer<TSource, TEventArgs...>* observer) { observers_.erase(observer); }
 
 protected:
-    void notify(TSource& source, TEventArgs... args)
+    void notify(TSource& source, EventParam<TEventArgs>... args)
+    {
+        for (auto&& observer : observers_)
+            observer->update(static_cast<TSource&>(*this), args...);
+    }
+
+    // every observer receives all events in one call
+    void notify_batch(TSource& source, std::span<const Event> events)
     {
+        if (events.empty())
+            return;
+
         for (auto&& observer : observers_)
-            observer->update(static_cast<TSource&>(*this), std::move(args...));
+            observer->update_batch(source, events);
     }
 
 private:
     std::set<Observer<TSource, TEventArgs...>*> observers_;
 };
 
+//////////////////////////////////////////////////////////////////////////////////////
+// Observable safe for concurrent notify/subscribe/unsubscribe
+// - observers are kept in an immutable snapshot array published atomically (copy-on-write)
+// - notify() is wait-free: it enters a read section (one increment of a per-thread-stripe counter),
+//   loads the raw snapshot pointer and scans it - no mutex, no shared reference count
+// - subscribe/unsubscribe may be called during notification (also from update());
+//   a notification already in flight may still reach an observer that has just been unsubscribed
+// - replaced snapshots are reclaimed by writers (epoch-based, RCU-like) once no read section
+//   that could have loaded them is active; writers never wait for readers
+template <typename TSource, typename... TEventArgs>
+class ConcurrentObservable
+{
+    using ObserverType = Observer<TSource, TEventArgs...>;
+    using Snapshot = std::vector<ObserverType*>;
+
+    static constexpr size_t stripes_count = 16;
+
+    struct alignas(64) ReaderCounter
+    {
+        std::atomic<size_t> value{0};
+    };
+
+    struct RetiredSnapshot
+    {
+        const Snapshot* snapshot;
+        uint64_t epoch;
+    };
+
+    std::atomic<const Snapshot*> observers_{new Snapshot{}};
+
+    // readers are counted per parity of the epoch in which they entered the read section
+    std::atomic<uint64_t> epoch_{0};
+    mutable ReaderCounter readers_[2][stripes_count];
+
+    std::mutex mtx_; // serializes writers
+    std::vector<RetiredSnapshot> retired_;
+
+    static size_t stripe()
+    {
+        static std::atomic<size_t> next_stripe{0};
+        thread_local const size_t thread_stripe = next_stripe.fetch_add(1, std::memory_order_relaxed) % stripes_count;
+        return thread_stripe;
+    }
+
+    class ReadSection
+    {
+        ReaderCounter& counter_;
+
+    public:
+        explicit ReadSection(const ConcurrentObservable& observable)
+            : counter_{observable.readers_[observable.epoch_.load() & 1][stripe()]}
+        {
+            counter_.value.fetch_add(1); // seq_cst - ordered before the load of the snapshot pointer
+        }
+
+        ReadSection(const ReadSection&) = delete;
+        ReadSection& operator=(const ReadSection&) = delete;
+
+        ~ReadSection()
+        {
+            counter_.value.fetch_sub(1, std::memory_order_release);
+        }
+    };
+
+    bool has_readers(uint64_t parity) const
+    {
+        return std::any_of(std::begin(readers_[parity]), std::end(readers_[parity]), [](const ReaderCounter& c) { return c.value.load() != 0; });
+    }
+
+    // called with mtx_ locked
+    void publish(const Snapshot* snapshot)
+    {
+        const Snapshot* replaced = observers_.exchange(snapshot);
+        retired_.push_back(RetiredSnapshot{replaced, epoch_.load()});
+
+        // the epoch advances when readers counted in the previous epoch have left;
+        // a snapshot retired in epoch E cannot be in use once the epoch reaches E + 2
+        const uint64_t epoch = epoch_.load();
+        if (!has_readers((epoch + 1) & 1))
+            epoch_.store(epoch + 1);
+
+        const uint64_t current_epoch = epoch_.load();
+        auto reclaimed_end = std::partition(retired_.begin(), retired_.end(), [current_epoch](const RetiredSnapshot& r) { return r.epoch + 2 > current_epoch; });
+        for (auto it = reclaimed_end; it != retired_.end(); ++it)
+            delete it->snapshot;
+        retired_.erase(reclaimed_end, retired_.end());
+    }
+
+public:
+    ConcurrentObservable() = default;
+    ConcurrentObservable(const ConcurrentObservable&) = delete;
+    ConcurrentObservable& operator=(const ConcurrentObservable&) = delete;
+
+    // no notification may be in progress
+    ~ConcurrentObservable()
+    {
+        delete observers_.load();
+        for (const auto& r : retired_)
+            delete r.snapshot;
+    }
+
+    void subscribe(ObserverType* observer)
+    {
+        std::lock_guard<std::mutex> lk{mtx_};
+
+        const Snapshot* current = observers_.load();
+        if (std::find(current->begin(), current->end(), observer) != current->end())
+            return;
+
+        auto updated = std::make_unique<Snapshot>(*current);
+        updated->push_back(observer);
+        publish(updated.release());
+    }
+
+    void unsubscribe(ObserverType* observer)
+    {
+        std::lock_guard<std::mutex> lk{mtx_};
+
+        const Snapshot* current = observers_.load();
+        if (std::find(current->begin(), current->end(), observer) == current->end())
+            return;
+
+        auto updated = std::make_unique<Snapshot>();
+        updated->reserve(current->size() - 1);
+        std::copy_if(current->begin(), current->end(), std::back_inserter(*updated), [observer](auto* o) { return o != observer; });
+        publish(updated.release());
+    }
+
+    size_t observer_count() const
+    {
+        ReadSection read_section{*this};
+        return observers_.load()->size();
+    }
+
+protected:
+    void notify(TSource& source, EventParam<TEventArgs>... args)
+    {
+        ReadSection read_section{*this}; // the snapshot is not reclaimed until the section ends
+
+        for (auto* observer : *observers_.load())
+            observer->update(source, args...);
+    }
+};
+
 #endif /*OBSERVER_HPP_*/
@@ -0,0 +1,327 @@
+#ifndef SIGNAL_HPP_
+#define SIGNAL_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Callable stored in an inline buffer - never allocates
+template <typename Signature, size_t BufferSize>
+class InplaceFunction;
+
+template <typename R, typename... Args, size_t BufferSize>
+class InplaceFunction<R(Args...), BufferSize>
+{
+    alignas(std::max_align_t) unsigned char buffer_[BufferSize];
+    R (*invoke_)(void*, Args...) = nullptr;
+    void (*relocate_)(void* dest, void* src) = nullptr; // moves src to dest (if not null) and destroys src
+
+public:
+    InplaceFunction() = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InplaceFunction>>>
+    InplaceFunction(F&& f)
+    {
+        using Callable = std::decay_t<F>;
+
+        static_assert(sizeof(Callable) <= BufferSize, "Callable is too big for an inline buffer");
+        static_assert(alignof(Callable) <= alignof(std::max_align_t), "Callable is over-aligned");
+        static_assert(std::is_nothrow_move_constructible_v<Callable>, "Callable must be nothrow movable");
+
+        ::new (static_cast<void*>(buffer_)) Callable(std::forward<F>(f));
+
+        invoke_ = [](void* callable, Args... args) -> R {
+            return (*static_cast<Callable*>(callable))(std::forward<Args>(args)...);
+        };
+
+        relocate_ = [](void* dest, void* src) {
+            auto* callable = static_cast<Callable*>(src);
+            if (dest)
+                ::new (dest) Callable(std::move(*callable));
+            callable->~Callable();
+        };
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept
+    {
+        move_from(other);
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            move_from(other);
+        }
+
+        return *this;
+    }
+
+    InplaceFunction(const InplaceFunction&) = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    ~InplaceFunction()
+    {
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        if (relocate_)
+            relocate_(nullptr, buffer_);
+
+        invoke_ = nullptr;
+        relocate_ = nullptr;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return invoke_ != nullptr;
+    }
+
+    R operator()(Args... args)
+    {
+        return invoke_(buffer_, std::forward<Args>(args)...);
+    }
+
+private:
+    void move_from(InplaceFunction& other) noexcept
+    {
+        if (other.relocate_)
+        {
+            other.relocate_(buffer_, other.buffer_);
+            invoke_ = std::exchange(other.invoke_, nullptr);
+            relocate_ = std::exchange(other.relocate_, nullptr);
+        }
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+namespace SignalThreading
+{
+    // no synchronization - signal is used by one thread only
+    struct SingleThreaded
+    {
+        struct Mutex
+        {
+            void lock()
+            {
+            }
+
+            void unlock()
+            {
+            }
+        };
+    };
+
+    // emission, subscribe & disconnect are serialized; slots may (dis)connect during emission.
+    // The mutex is held while slots are called: emissions from different threads do not run in parallel,
+    // and a slot must not wait for another thread that emits, subscribes or disconnects on the same signal
+    // (deadlock).
+    struct MultiThreaded
+    {
+        using Mutex = std::recursive_mutex;
+    };
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Signal with slots kept in inline storage:
+// - the first InlineSlotsCount slots live inside the signal - subscribing does not allocate
+// - each slot stores its callable in an inline buffer of SlotBufferSize bytes
+// - slots may subscribe/disconnect during emission; slots added during emission are called from the next one
+// A Connection must not be used after its signal is destroyed.
+template <typename Signature, typename ThreadingPolicy = SignalThreading::SingleThreaded, size_t InlineSlotsCount = 4, size_t SlotBufferSize = 32>
+class Signal;
+
+template <typename... Args, typename ThreadingPolicy, size_t InlineSlotsCount, size_t SlotBufferSize>
+class Signal<void(Args...), ThreadingPolicy, InlineSlotsCount, SlotBufferSize>
+{
+    using SlotId = uint64_t;
+    using Slot = InplaceFunction<void(Args...), SlotBufferSize>;
+
+    struct SlotEntry
+    {
+        SlotId id = 0; // 0 - empty or disconnected
+        Slot slot;
+    };
+
+    std::array<SlotEntry, InlineSlotsCount> inline_slots_;
+    std::deque<SlotEntry> overflow_slots_; // deque - entries do not move when slots are added during emission
+    size_t slots_count_ = 0;
+    SlotId next_id_ = 1;
+    size_t emission_depth_ = 0;
+    bool needs_compaction_ = false;
+    typename ThreadingPolicy::Mutex mtx_;
+
+    SlotEntry& entry(size_t index)
+    {
+        return index < InlineSlotsCount ? inline_slots_[index] : overflow_slots_[index - InlineSlotsCount];
+    }
+
+    void disconnect(SlotId id)
+    {
+        std::lock_guard<typename ThreadingPolicy::Mutex> lk{mtx_};
+
+        for (size_t i = 0; i < slots_count_; ++i)
+        {
+            if (auto& e = entry(i); e.id == id)
+            {
+                e.id = 0;
+                needs_compaction_ = true;
+                break;
+            }
+        }
+
+        if (emission_depth_ == 0)
+            compact();
+    }
+
+    bool is_connected(SlotId id)
+    {
+        std::lock_guard<typename ThreadingPolicy::Mutex> lk{mtx_};
+
+        for (size_t i = 0; i < slots_count_; ++i)
+            if (entry(i).id == id)
+                return true;
+
+        return false;
+    }
+
+    // tracks nested emissions - disconnected slots are compacted when the outermost one ends (also by an exception)
+    class EmissionGuard
+    {
+        Signal& signal_;
+
+    public:
+        explicit EmissionGuard(Signal& signal)
+            : signal_{signal}
+        {
+            ++signal_.emission_depth_;
+        }
+
+        EmissionGuard(const EmissionGuard&) = delete;
+        EmissionGuard& operator=(const EmissionGuard&) = delete;
+
+        ~EmissionGuard()
+        {
+            if (--signal_.emission_depth_ == 0)
+                signal_.compact();
+        }
+    };
+
+    // removes disconnected slots preserving the order of connected ones
+    void compact()
+    {
+        if (!needs_compaction_)
+            return;
+
+        size_t connected_count = 0;
+        for (size_t i = 0; i < slots_count_; ++i)
+        {
+            auto& e = entry(i);
+            if (e.id == 0)
+                continue;
+
+            if (connected_count != i)
+            {
+                auto& dest = entry(connected_count);
+                dest.id = std::exchange(e.id, 0);
+                dest.slot = std::move(e.slot);
+            }
+            ++connected_count;
+        }
+
+        for (size_t i = connected_count; i < slots_count_; ++i)
+            entry(i).slot.reset();
+
+        slots_count_ = connected_count;
+        if (slots_count_ < InlineSlotsCount + overflow_slots_.size())
+            overflow_slots_.resize(slots_count_ > InlineSlotsCount ? slots_count_ - InlineSlotsCount : 0);
+
+        needs_compaction_ = false;
+    }
+
+public:
+    class Connection
+    {
+        Signal* signal_ = nullptr;
+        SlotId id_ = 0;
+
+    public:
+        Connection() = default;
+
+        Connection(Signal* signal, SlotId id)
+            : signal_{signal}
+            , id_{id}
+        {
+        }
+
+        void disconnect()
+        {
+            if (signal_)
+                signal_->disconnect(std::exchange(id_, 0));
+            signal_ = nullptr;
+        }
+
+        bool connected() const
+        {
+            return signal_ && signal_->is_connected(id_);
+        }
+    };
+
+    Signal() = default;
+    Signal(const Signal&) = delete;
+    Signal& operator=(const Signal&) = delete;
+
+    template <typename F>
+    Connection subscribe(F&& slot)
+    {
+        std::lock_guard<typename ThreadingPolicy::Mutex> lk{mtx_};
+
+        if (slots_count_ >= InlineSlotsCount)
+            overflow_slots_.emplace_back();
+
+        auto& e = entry(slots_count_);
+        e.id = next_id_++;
+        e.slot = Slot{std::forward<F>(slot)};
+        ++slots_count_;
+
+        return Connection{this, e.id};
+    }
+
+    // if a slot throws, the exception propagates to the caller and remaining slots are not called
+    void operator()(Args... args)
+    {
+        std::lock_guard<typename ThreadingPolicy::Mutex> lk{mtx_};
+
+        EmissionGuard emission{*this};
+
+        const size_t count = slots_count_;
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto& e = entry(i);
+            if (e.id != 0)
+                e.slot(args...);
+        }
+    }
+
+    size_t slots_count()
+    {
+        std::lock_guard<typename ThreadingPolicy::Mutex> lk{mtx_};
+
+        size_t connected_count = 0;
+        for (size_t i = 0; i < slots_count_; ++i)
+            connected_count += (entry(i).id != 0);
+
+        return connected_count;
+    }
+};
+
+#endif /*SIGNAL_HPP_*/
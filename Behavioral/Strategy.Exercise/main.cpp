@@ -1,10 +1,14 @@
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <list>
+#include <memory>
 #include <numeric>
+#include <random>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -24,10 +28,72 @@ struct StatResult
 using Data = std::vector<double>;
 using Results = std::vector<StatResult>;
 
+// Sum, Min & Max computed in a single pass over data
+struct DataSummary
+{
+    double sum = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    size_t count = 0;
+};
+
+// Scalar code - nothing is SIMD-vectorized: the in-order sum is a serial dependency chain
+// (reassociating it would change rounding). The gain comes from reading data once instead of once per statistic.
+// Min & max are the values returned by std::min_element/std::max_element for data without NaNs;
+// when both -0.0 and 0.0 are the extreme, either of them may be returned. NaNs are ignored here,
+// while std::min_element/std::max_element return a NaN that is the first element.
+DataSummary summarize(const Data& data)
+{
+    constexpr size_t lanes = 4; // independent min/max accumulators - shorter dependency chains
+
+    double mins[lanes], maxs[lanes];
+    std::fill(std::begin(mins), std::end(mins), std::numeric_limits<double>::infinity());
+    std::fill(std::begin(maxs), std::end(maxs), -std::numeric_limits<double>::infinity());
+
+    // sum is accumulated in order - exactly as std::accumulate, so results do not change
+    double sum = 0.0;
+
+    const double* values = data.data();
+    const size_t size = data.size();
+    const size_t blocks_end = size - size % lanes;
+
+    for (size_t i = 0; i < blocks_end; i += lanes)
+    {
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            const double value = values[i + lane];
+            sum += value;
+            mins[lane] = value < mins[lane] ? value : mins[lane];
+            maxs[lane] = maxs[lane] < value ? value : maxs[lane];
+        }
+    }
+
+    for (size_t i = blocks_end; i < size; ++i)
+    {
+        sum += values[i];
+        mins[0] = values[i] < mins[0] ? values[i] : mins[0];
+        maxs[0] = maxs[0] < values[i] ? values[i] : maxs[0];
+    }
+
+    return DataSummary{sum, *std::min_element(std::begin(mins), std::end(mins)), *std::max_element(std::begin(maxs), std::end(maxs)), size};
+}
+
 class Statistics
 {
 public:
     virtual Results calculateStatistics(const Data& data) const = 0;
+
+    // statistics composable from DataSummary return true - StatGroup computes the summary once for all of them
+    virtual bool usesSummary() const
+    {
+        return false;
+    }
+
+    virtual Results calculateFromSummary(const Data& data, const DataSummary&) const
+    {
+        return calculateStatistics(data);
+    }
+
     virtual ~Statistics() = default;
 };
 
@@ -41,6 +107,16 @@ public:
 
         return Results{StatResult("Avg", avg)};
     }
+
+    bool usesSummary() const override
+    {
+        return true;
+    }
+
+    Results calculateFromSummary(const Data&, const DataSummary& summary) const override
+    {
+        return Results{StatResult("Avg", summary.sum / summary.count)};
+    }
 };
 
 class MinStat : public Statistics
@@ -52,6 +128,16 @@ public:
 
         return Results{StatResult("Min", min)};
     }
+
+    bool usesSummary() const override
+    {
+        return true;
+    }
+
+    Results calculateFromSummary(const Data&, const DataSummary& summary) const override
+    {
+        return Results{StatResult("Min", summary.min)};
+    }
 };
 
 class MaxStat : public Statistics
@@ -63,6 +149,16 @@ public:
 
         return Results{StatResult("Max", max)};
     }
+
+    bool usesSummary() const override
+    {
+        return true;
+    }
+
+    Results calculateFromSummary(const Data&, const DataSummary& summary) const override
+    {
+        return Results{StatResult("Max", summary.max)};
+    }
 };
 
 class SumStat : public Statistics
@@ -74,6 +170,16 @@ public:
 
         return Results{StatResult("Sum", sum)};
     }
+
+    bool usesSummary() const override
+    {
+        return true;
+    }
+
+    Results calculateFromSummary(const Data&, const DataSummary& summary) const override
+    {
+        return Results{StatResult("Sum", summary.sum)};
+    }
 };
 
 class StatGroup : public Statistics
@@ -88,6 +194,9 @@ public:
 
     Results calculateStatistics(const Data& data) const override
     {
+        if (usesSummary())
+            return calculateFromSummary(data, summarize(data));
+
         Results results;
         for (const auto& stat : stats_)
         {
@@ -97,6 +206,23 @@ public:
 
         return results;
     }
+
+    bool usesSummary() const override
+    {
+        return std::any_of(stats_.begin(), stats_.end(), [](const auto& stat) { return stat->usesSummary(); });
+    }
+
+    Results calculateFromSummary(const Data& data, const DataSummary& summary) const override
+    {
+        Results results;
+        for (const auto& stat : stats_)
+        {
+            Results res = stat->calculateFromSummary(data, summary);
+            results.insert(results.end(), res.begin(), res.end());
+        }
+
+        return results;
+    }
 };
 
 class DataAnalyzer
@@ -264,7 +390,37 @@ void show_results(const Results& results)
         std::cout << rslt.description << " = " << rslt.value << std::endl;
 }
 
-int main()
+void benchmark_statistics(const std::shared_ptr<Statistics>& std_stats, const std::vector<std::shared_ptr<Statistics>>& separate_stats, size_t count)
+{
+    std::mt19937_64 rnd{665};
+    std::uniform_real_distribution<double> distribution{-1000.0, 1000.0};
+    Data data(count);
+    std::generate(data.begin(), data.end(), [&] { return distribution(rnd); });
+
+    const double giga_bytes = count * sizeof(double) / 1e9;
+
+    auto start = std::chrono::steady_clock::now();
+    Results separate_results;
+    for (const auto& stat : separate_stats)
+    {
+        Results res = stat->calculateStatistics(data);
+        separate_results.insert(separate_results.end(), res.begin(), res.end());
+    }
+    std::chrono::duration<double> separate_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    Results fused_results = std_stats->calculateStatistics(data);
+    std::chrono::duration<double> fused_time = std::chrono::steady_clock::now() - start;
+
+    const bool are_equal = std::equal(separate_results.begin(), separate_results.end(), fused_results.begin(), fused_results.end(),
+        [](const StatResult& a, const StatResult& b) { return a.description == b.description && a.value == b.value; });
+
+    std::cout << "Statistics of " << count << " values - separate passes: " << separate_time.count() * 1000 << "ms ("
+              << giga_bytes / separate_time.count() << " GB/s), fused pass: " << fused_time.count() * 1000 << "ms ("
+              << giga_bytes / fused_time.count() << " GB/s)" << (are_equal ? "" : " - RESULTS DIFFER!") << '\n';
+}
+
+int main(int argc, char* argv[])
 {
     std::shared_ptr<Statistics> avg = std::make_shared<AverageStat>();
     auto min_max = std::make_shared<StatGroup>();
@@ -287,4 +443,12 @@ int main()
     da.load_data("new_stats_data.dat");
     da.calculate();
     show_results(da.results());
+
+    // the benchmark allocates 800 MB of data - it is run on request only
+    if (argc < 2 || std::string{argv[1]} != "--benchmark")
+        return 0;
+
+    std::cout << "\n\n";
+
+    benchmark_statistics(std_stats, {avg, std::make_shared<MinStat>(), std::make_shared<MaxStat>(), sum}, 100'000'000);
 }
@@ -1,11 +1,352 @@
+#include <chrono>
 #include <iostream>
+#include <random>
+#include <string>
 
 #include "src/ast.hpp"
+#include "src/bytecode.hpp"
+#include "src/flat_ast.hpp"
+#include "src/optimizer.hpp"
+#include "src/parallel_eval.hpp"
+#include "src/static_ast.hpp"
+#include "src/streaming_printer.hpp"
+#include "src/variant_ast.hpp"
 #include "src/visitors.hpp"
 
 using namespace std;
 
-int main()
+// Random expression with nodes_count nodes (odd number).
+// Multiplications combine only two integers, so the result does not overflow int.
+void generate_expression(AST::FlatExpression& expr, size_t nodes_count, mt19937_64& rnd)
+{
+    if (nodes_count == 1)
+    {
+        expr.integer(static_cast<int>(rnd() % 10));
+        return;
+    }
+
+    if (nodes_count == 3 && rnd() % 2 == 0)
+    {
+        expr.integer(static_cast<int>(rnd() % 10));
+        expr.integer(static_cast<int>(rnd() % 10));
+        expr.multiply();
+        return;
+    }
+
+    const size_t children_count = nodes_count - 1;
+    const size_t left_count = 2 * (rnd() % (children_count / 2)) + 1;
+
+    generate_expression(expr, left_count, rnd);
+    generate_expression(expr, children_count - left_count, rnd);
+    expr.add();
+}
+
+void benchmark_flat_ast(size_t nodes_count)
+{
+    mt19937_64 rnd{665};
+
+    AST::FlatExpression expr;
+    expr.reserve(nodes_count);
+
+    auto start = chrono::steady_clock::now();
+    generate_expression(expr, nodes_count, rnd);
+    chrono::duration<double, milli> flat_build_time = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    AST::ExpressionNodePtr tree = AST::to_tree(expr);
+    chrono::duration<double, milli> tree_build_time = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    ExprEvalVisitor evaluator;
+    tree->accept(evaluator);
+    chrono::duration<double, milli> tree_eval_time = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    int flat_result = AST::evaluate(expr);
+    chrono::duration<double, milli> flat_eval_time = chrono::steady_clock::now() - start;
+
+    cout << "Expression of " << expr.size() << " nodes:\n"
+         << "  tree - build " << tree_build_time.count() << "ms, evaluate " << tree_eval_time.count() << "ms = " << evaluator.result() << '\n'
+         << "  flat - build " << flat_build_time.count() << "ms (including random generation), evaluate " << flat_eval_time.count() << "ms = " << flat_result << '\n';
+}
+
+// Random tree with nodes_count nodes (odd number); leaves are small integers or variables x, y, z
+AST::ExpressionNodePtr generate_tree_with_variables(size_t nodes_count, mt19937_64& rnd)
+{
+    using namespace AST::helpers;
+
+    static const string variables[] = {"x", "y", "z"};
+
+    auto leaf = [&rnd]() {
+        return rnd() % 2 == 0 ? integer(static_cast<int>(rnd() % 10)) : variable(variables[rnd() % 3]);
+    };
+
+    if (nodes_count == 1)
+        return leaf();
+
+    if (nodes_count == 3 && rnd() % 2 == 0)
+        return multiply(leaf(), leaf());
+
+    const size_t children_count = nodes_count - 1;
+    const size_t left_count = 2 * (rnd() % (children_count / 2)) + 1;
+
+    auto left = generate_tree_with_variables(left_count, rnd);
+    auto right = generate_tree_with_variables(children_count - left_count, rnd);
+
+    return add(move(left), move(right));
+}
+
+void benchmark_bytecode(size_t nodes_count, int evaluations_count)
+{
+    mt19937_64 rnd{665};
+    AST::ExpressionNodePtr expr = generate_tree_with_variables(nodes_count, rnd);
+
+    AST::Bindings bindings{{"x", 0}, {"y", 1}, {"z", 2}};
+    long long visitor_checksum = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < evaluations_count; ++i)
+    {
+        bindings["x"] = i % 10;
+        ExprEvalVisitor evaluator{bindings};
+        expr->accept(evaluator);
+        visitor_checksum += evaluator.result();
+    }
+    chrono::duration<double, micro> visitor_time = chrono::steady_clock::now() - start;
+
+    AST::Program program = AST::compile(*expr);
+    vector<int> values = program.bind(bindings);
+    const size_t x_slot = program.variable_slot("x");
+    AST::VirtualMachine vm;
+    long long vm_checksum = 0;
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < evaluations_count; ++i)
+    {
+        if (x_slot != AST::Program::npos)
+            values[x_slot] = i % 10;
+        vm_checksum += vm.run(program, values);
+    }
+    chrono::duration<double, micro> vm_time = chrono::steady_clock::now() - start;
+
+    cout << "Expression of " << nodes_count << " nodes (" << program.code().size() << " instructions) - "
+         << "ExprEvalVisitor: " << visitor_time.count() / evaluations_count << "us"
+         << ", bytecode VM: " << vm_time.count() / evaluations_count << "us per evaluation"
+         << (visitor_checksum == vm_checksum ? "" : " - RESULTS DIFFER!") << '\n';
+}
+
+// Workload with repeated subexpressions - copies_count random subtrees drawn from a pool of pool_size shapes
+AST::ExpressionNodePtr generate_redundant_tree(size_t copies_count, size_t pool_size, size_t subtree_nodes_count, mt19937_64& rnd)
+{
+    if (copies_count == 1)
+    {
+        mt19937_64 subtree_rnd{rnd() % pool_size}; // the same seed - the same subtree
+        return generate_tree_with_variables(subtree_nodes_count, subtree_rnd);
+    }
+
+    const size_t left_count = copies_count / 2;
+    auto left = generate_redundant_tree(left_count, pool_size, subtree_nodes_count, rnd);
+    auto right = generate_redundant_tree(copies_count - left_count, pool_size, subtree_nodes_count, rnd);
+
+    return AST::helpers::add(move(left), move(right));
+}
+
+void benchmark_optimizer(size_t copies_count, size_t pool_size)
+{
+    constexpr int evaluations_count = 100;
+
+    mt19937_64 rnd{665};
+    AST::ExpressionNodePtr expr = generate_redundant_tree(copies_count, pool_size, 31, rnd);
+    AST::Bindings bindings{{"x", 1}, {"y", 2}, {"z", 3}};
+
+    auto start = chrono::steady_clock::now();
+    AST::ExpressionNodePtr folded = AST::fold_constants(*expr);
+    AST::ExpressionDag dag = AST::build_dag(*folded);
+    chrono::duration<double, milli> optimization_time = chrono::steady_clock::now() - start;
+
+    int tree_result = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < evaluations_count; ++i)
+    {
+        ExprEvalVisitor evaluator{bindings};
+        expr->accept(evaluator);
+        tree_result = evaluator.result();
+    }
+    chrono::duration<double, micro> tree_time = chrono::steady_clock::now() - start;
+
+    int dag_result = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < evaluations_count; ++i)
+        dag_result = dag.evaluate(bindings);
+    chrono::duration<double, micro> dag_time = chrono::steady_clock::now() - start;
+
+    cout << "Optimizer - nodes: " << AST::count_nodes(*expr) << " -> " << AST::count_nodes(*folded) << " after folding -> "
+         << dag.size() << " unique nodes in DAG (optimization " << optimization_time.count() << "ms)\n"
+         << "  evaluation - tree: " << tree_time.count() / evaluations_count << "us, DAG: " << dag_time.count() / evaluations_count
+         << "us, speedup: " << tree_time.count() / dag_time.count() << "x"
+         << (tree_result == dag_result ? "" : " - RESULTS DIFFER!") << '\n';
+}
+
+// Balanced random tree with nodes_count nodes (odd number)
+AST::ExpressionNodePtr generate_balanced_tree(size_t nodes_count, mt19937_64& rnd)
+{
+    using namespace AST::helpers;
+
+    if (nodes_count == 1)
+        return rnd() % 4 == 0 ? variable("x") : integer(static_cast<int>(rnd() % 10));
+
+    if (nodes_count == 3)
+        return multiply(generate_balanced_tree(1, rnd), generate_balanced_tree(1, rnd));
+
+    const size_t children_count = nodes_count - 1;
+    const size_t left_count = children_count / 2 % 2 == 1 ? children_count / 2 : children_count / 2 + 1;
+
+    auto left = generate_balanced_tree(left_count, rnd);
+    auto right = generate_balanced_tree(children_count - left_count, rnd);
+
+    return add(move(left), move(right));
+}
+
+void benchmark_parallel_evaluation(size_t nodes_count)
+{
+    mt19937_64 rnd{665};
+    AST::ExpressionNodePtr expr = generate_balanced_tree(nodes_count, rnd);
+    AST::Bindings bindings{{"x", 7}};
+
+    auto start = chrono::steady_clock::now();
+    ExprEvalVisitor evaluator{bindings};
+    expr->accept(evaluator);
+    chrono::duration<double, milli> sequential_time = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    const vector<uint32_t> sizes = AST::subtree_sizes(*expr);
+    chrono::duration<double, milli> sizes_time = chrono::steady_clock::now() - start;
+
+    cout << "Parallel evaluation of " << nodes_count << " nodes - ExprEvalVisitor: " << sequential_time.count() << "ms"
+         << ", subtree sizes: " << sizes_time.count() << "ms\n";
+
+    const size_t max_threads_count = max(thread::hardware_concurrency(), 1u);
+    for (size_t threads_count = 1;; threads_count = min(2 * threads_count, max_threads_count))
+    {
+        AST::ParallelEvaluator parallel{threads_count};
+
+        start = chrono::steady_clock::now();
+        const int result = parallel.evaluate(*expr, sizes, bindings);
+        chrono::duration<double, milli> parallel_time = chrono::steady_clock::now() - start;
+
+        cout << "  " << threads_count << " thread(s): " << parallel_time.count() << "ms, speedup: " << sequential_time.count() / parallel_time.count() << "x"
+             << (result == evaluator.result() ? "" : " - RESULTS DIFFER!") << '\n';
+
+        if (threads_count == max_threads_count)
+            break;
+    }
+}
+
+void benchmark_printing(const string& name, AST::ExpressionNode& expr)
+{
+    auto start = chrono::steady_clock::now();
+    PrintingVisitor printer;
+    expr.accept(printer);
+    const string visitor_text = printer.str();
+    chrono::duration<double, milli> visitor_time = chrono::steady_clock::now() - start;
+
+    string buffer;
+    start = chrono::steady_clock::now();
+    AST::print(expr, buffer);
+    chrono::duration<double, milli> streaming_time = chrono::steady_clock::now() - start;
+
+    cout << "Printing " << name << " (" << buffer.size() << " chars) - PrintingVisitor: " << visitor_time.count() << "ms"
+         << ", StreamingPrinter: " << streaming_time.count() << "ms"
+         << (visitor_text == buffer ? "" : " - OUTPUTS DIFFER!") << '\n';
+}
+
+void benchmark_printing()
+{
+    mt19937_64 rnd{665};
+    AST::ExpressionNodePtr random_tree = generate_tree_with_variables(1'000'001, rnd);
+    benchmark_printing("random tree", *random_tree);
+
+    AST::ExpressionNodePtr deep_tree = AST::helpers::integer(0);
+    for (int i = 1; i <= 10'000; ++i)
+        deep_tree = AST::helpers::add(move(deep_tree), AST::helpers::variable("x"));
+    benchmark_printing("deep tree", *deep_tree);
+}
+
+void benchmark_variant_ast(size_t nodes_count)
+{
+    mt19937_64 rnd{665};
+    AST::FlatExpression flat_expr;
+    flat_expr.reserve(nodes_count);
+    generate_expression(flat_expr, nodes_count, rnd);
+
+    AST::ExpressionNodePtr tree = AST::to_tree(flat_expr);
+    const AST::cpp17::Expression expr = AST::cpp17::from_tree(*tree);
+
+    auto start = chrono::steady_clock::now();
+    ExprEvalVisitor evaluator;
+    tree->accept(evaluator);
+    chrono::duration<double, milli> virtual_eval_time = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    const int variant_result = AST::cpp17::evaluate(expr);
+    chrono::duration<double, milli> variant_eval_time = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    const string virtual_text = AST::print(*tree);
+    chrono::duration<double, milli> virtual_print_time = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    const string variant_text = AST::cpp17::print(expr);
+    chrono::duration<double, milli> variant_print_time = chrono::steady_clock::now() - start;
+
+    cout << "Variant AST of " << expr.size() << " nodes:\n"
+         << "  evaluate - virtual (ExprEvalVisitor): " << virtual_eval_time.count() << "ms, variant: " << variant_eval_time.count() << "ms"
+         << (evaluator.result() == variant_result ? "" : " - RESULTS DIFFER!") << '\n'
+         << "  print - virtual (StreamingPrinter): " << virtual_print_time.count() << "ms, variant: " << variant_print_time.count() << "ms"
+         << (virtual_text == variant_text ? "" : " - OUTPUTS DIFFER!") << '\n';
+}
+
+// hot fixed formula: (v + 3) * (2 * v + 1) + 7 * 6
+void benchmark_static_expression(int evaluations_count)
+{
+    namespace se = AST::static_expr;
+
+    constexpr auto constant_part = se::multiply(se::integer(7), se::integer(6));
+    static_assert(constant_part.evaluate() == 42);
+
+    using namespace AST::helpers;
+    auto tree = add(multiply(add(variable("v"), integer(3)), add(multiply(integer(2), variable("v")), integer(1))), se::to_tree(constant_part));
+
+    AST::Bindings bindings{{"v", 0}};
+    long long tree_checksum = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < evaluations_count; ++i)
+    {
+        bindings["v"] = i % 100;
+        ExprEvalVisitor evaluator{bindings};
+        tree->accept(evaluator);
+        tree_checksum += evaluator.result();
+    }
+    chrono::duration<double, nano> tree_time = chrono::steady_clock::now() - start;
+
+    long long static_checksum = 0;
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < evaluations_count; ++i)
+    {
+        const auto v = se::integer(i % 100);
+        const auto expr = se::add(se::multiply(se::add(v, se::integer(3)), se::add(se::multiply(se::integer(2), v), se::integer(1))), constant_part);
+        static_checksum += expr.evaluate();
+    }
+    chrono::duration<double, nano> static_time = chrono::steady_clock::now() - start;
+
+    cout << "Fixed formula - ExprEvalVisitor: " << tree_time.count() / evaluations_count << "ns"
+         << ", expression template: " << static_time.count() / evaluations_count << "ns per evaluation"
+         << (tree_checksum == static_checksum ? "" : " - RESULTS DIFFER!") << '\n';
+}
+
+int main(int argc, char* argv[])
 {
     using namespace AST::helpers;
 
@@ -15,9 +356,27 @@ int main()
     expr->accept(evaluator);
 
     // TODO - uncomment code
-    
+
     // PrintingVisitor printer;
     // expr->accept(printer);
 
     // cout << printer.str() << " = " << evaluator.result() << std::endl;
+
+    // benchmarks build expressions of up to 10M nodes - they are run on request only
+    if (argc < 2 || string{argv[1]} != "--benchmark")
+        return 0;
+
+    benchmark_flat_ast(10'000'001);
+
+    benchmark_bytecode(1'001, 10'000);
+
+    benchmark_optimizer(10'000, 100);
+
+    benchmark_parallel_evaluation(10'000'001);
+
+    benchmark_printing();
+
+    benchmark_variant_ast(1'000'001);
+
+    benchmark_static_expression(1'000'000);
 }
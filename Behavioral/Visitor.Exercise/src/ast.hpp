@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 namespace AST
 {
@@ -10,11 +11,15 @@ namespace AST
     class AddNode;
     class MultiplyNode;
     class IntNode;
+    class VariableNode;
 
     using ExpressionNodePtr = std::unique_ptr<ExpressionNode>;
     using AddNodePtr = std::unique_ptr<AddNode>;
     using MultiplyNodePtr = std::unique_ptr<MultiplyNode>;
 
+    // values of variables used in an expression
+    using Bindings = std::unordered_map<std::string, int>;
+
     struct AstVisitor
     {
         virtual ~AstVisitor() = default;
@@ -22,6 +27,7 @@ namespace AST
         virtual void visit(AddNode& node) = 0;
         virtual void visit(MultiplyNode& node) = 0;
         virtual void visit(IntNode& node) = 0;
+        virtual void visit(VariableNode& node) = 0;
     };
 
     class ExpressionNode
@@ -99,22 +105,42 @@ namespace AST
         }
     };
 
+    class VariableNode : public VisitableExpression<VariableNode>
+    {
+        std::string name_;
+
+    public:
+        VariableNode(std::string name) : name_{std::move(name)}
+        {
+        }
+
+        const std::string& name() const
+        {
+            return name_;
+        }
+    };
+
     namespace helpers
     {
-        AddNodePtr add(ExpressionNodePtr left, ExpressionNodePtr right)
+        inline AddNodePtr add(ExpressionNodePtr left, ExpressionNodePtr right)
         {
             return std::make_unique<AddNode>(std::move(left), std::move(right));
         }
 
-        ExpressionNodePtr integer(int value)
+        inline ExpressionNodePtr integer(int value)
         {
             return std::make_unique<IntNode>(value);
         }
 
-        MultiplyNodePtr multiply(ExpressionNodePtr left, ExpressionNodePtr right)
+        inline MultiplyNodePtr multiply(ExpressionNodePtr left, ExpressionNodePtr right)
         {
             return std::make_unique<MultiplyNode>(std::move(left), std::move(right));
         }
+
+        inline ExpressionNodePtr variable(std::string name)
+        {
+            return std::make_unique<VariableNode>(std::move(name));
+        }
     }
 }
 
@@ -0,0 +1,116 @@
+#include "bytecode.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace AST
+{
+    size_t Program::variable_slot(const std::string& name) const
+    {
+        auto pos = std::find(variables_.begin(), variables_.end(), name);
+
+        return pos != variables_.end() ? static_cast<size_t>(pos - variables_.begin()) : npos;
+    }
+
+    std::vector<int> Program::bind(const Bindings& bindings) const
+    {
+        std::vector<int> values;
+        values.reserve(variables_.size());
+
+        for (const auto& name : variables_)
+            values.push_back(bindings.at(name));
+
+        return values;
+    }
+
+    void BytecodeCompiler::emit(OpCode op, int operand)
+    {
+        program_.code_.push_back(Instruction{op, operand});
+
+        if (op == OpCode::push_int || op == OpCode::load_variable)
+            program_.max_stack_depth_ = std::max(program_.max_stack_depth_, ++stack_depth_);
+        else
+            --stack_depth_; // binary operation: pops two operands, pushes the result
+    }
+
+    void BytecodeCompiler::visit(AddNode& node)
+    {
+        node.left().accept(*this);
+        node.right().accept(*this);
+        emit(OpCode::add, 0);
+    }
+
+    void BytecodeCompiler::visit(MultiplyNode& node)
+    {
+        node.left().accept(*this);
+        node.right().accept(*this);
+        emit(OpCode::multiply, 0);
+    }
+
+    void BytecodeCompiler::visit(IntNode& node)
+    {
+        emit(OpCode::push_int, node.value());
+    }
+
+    void BytecodeCompiler::visit(VariableNode& node)
+    {
+        size_t slot = program_.variable_slot(node.name());
+
+        if (slot == Program::npos)
+        {
+            slot = program_.variables_.size();
+            program_.variables_.push_back(node.name());
+        }
+
+        emit(OpCode::load_variable, static_cast<int>(slot));
+    }
+
+    Program compile(ExpressionNode& expr)
+    {
+        BytecodeCompiler compiler;
+        expr.accept(compiler);
+
+        return compiler.program();
+    }
+
+    int VirtualMachine::run(const Program& program, const int* variable_values)
+    {
+        if (program.code().empty())
+            throw std::invalid_argument("Empty program");
+
+        stack_.resize(program.max_stack_depth());
+
+        int* top = stack_.data(); // one past the top element
+
+        for (const Instruction& instruction : program.code())
+        {
+            switch (instruction.op)
+            {
+            case OpCode::push_int:
+                *top++ = instruction.operand;
+                break;
+            case OpCode::load_variable:
+                *top++ = variable_values[instruction.operand];
+                break;
+            case OpCode::add:
+                --top;
+                top[-1] += top[0];
+                break;
+            case OpCode::multiply:
+                --top;
+                top[-1] *= top[0];
+                break;
+            }
+        }
+
+        return top[-1];
+    }
+
+    int VirtualMachine::run(const Program& program, const std::vector<int>& variable_values)
+    {
+        if (variable_values.size() < program.variables().size())
+            throw std::invalid_argument("Not all variables are bound");
+
+        return run(program, variable_values.data());
+    }
+}
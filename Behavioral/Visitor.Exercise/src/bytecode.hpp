@@ -0,0 +1,95 @@
+#ifndef BYTECODE_HPP
+#define BYTECODE_HPP
+
+#include "ast.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AST
+{
+    enum class OpCode : uint8_t
+    {
+        push_int,      // operand - value
+        load_variable, // operand - variable slot
+        add,
+        multiply
+    };
+
+    struct Instruction
+    {
+        OpCode op;
+        int operand;
+    };
+
+    // Expression compiled to a stack-based bytecode.
+    // Variables are referred to by slots - values are passed to run() as an array indexed by slot.
+    class Program
+    {
+        std::vector<Instruction> code_;
+        std::vector<std::string> variables_; // slot -> name
+        size_t max_stack_depth_ = 0;
+
+        friend class BytecodeCompiler;
+
+    public:
+        const std::vector<Instruction>& code() const
+        {
+            return code_;
+        }
+
+        const std::vector<std::string>& variables() const
+        {
+            return variables_;
+        }
+
+        size_t max_stack_depth() const
+        {
+            return max_stack_depth_;
+        }
+
+        // returns npos for variables not used in the expression
+        static constexpr size_t npos = static_cast<size_t>(-1);
+        size_t variable_slot(const std::string& name) const;
+
+        // values of variables in slot order; throws std::out_of_range for unbound variables
+        std::vector<int> bind(const Bindings& bindings) const;
+    };
+
+    // Visitor lowering the AST to bytecode (postorder)
+    class BytecodeCompiler : public AstVisitor
+    {
+        Program program_;
+        size_t stack_depth_ = 0;
+
+        void emit(OpCode op, int operand);
+
+    public:
+        void visit(AddNode& node) override;
+        void visit(MultiplyNode& node) override;
+        void visit(IntNode& node) override;
+        void visit(VariableNode& node) override;
+
+        Program program() const
+        {
+            return program_;
+        }
+    };
+
+    Program compile(ExpressionNode& expr);
+
+    // Interpreter of compiled expressions - reuses its stack between runs
+    class VirtualMachine
+    {
+        std::vector<int> stack_;
+
+    public:
+        // variable_values must hold a value for every slot of the program
+        int run(const Program& program, const int* variable_values);
+
+        int run(const Program& program, const std::vector<int>& variable_values = {});
+    };
+}
+
+#endif // BYTECODE_HPP
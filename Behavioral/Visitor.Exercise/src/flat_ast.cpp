@@ -0,0 +1,188 @@
+#include "flat_ast.hpp"
+
+#include <stdexcept>
+
+namespace AST
+{
+    void FlatExpression::reserve(size_t nodes_count)
+    {
+        nodes_.reserve(nodes_count);
+    }
+
+    FlatExpression::NodeIndex FlatExpression::integer(int value)
+    {
+        const auto index = static_cast<NodeIndex>(nodes_.size());
+        nodes_.push_back(Node{NodeKind::integer, value, 0, 0});
+        open_subtrees_.push_back(index);
+
+        return index;
+    }
+
+    FlatExpression::NodeIndex FlatExpression::push_binary(NodeKind kind)
+    {
+        if (open_subtrees_.size() < 2)
+            throw std::logic_error("Binary node requires two operands");
+
+        const NodeIndex right = open_subtrees_.back();
+        open_subtrees_.pop_back();
+        const NodeIndex left = open_subtrees_.back();
+
+        const auto index = static_cast<NodeIndex>(nodes_.size());
+        nodes_.push_back(Node{kind, 0, left, right});
+        open_subtrees_.back() = index;
+
+        return index;
+    }
+
+    FlatExpression::NodeIndex FlatExpression::add()
+    {
+        return push_binary(NodeKind::add);
+    }
+
+    FlatExpression::NodeIndex FlatExpression::multiply()
+    {
+        return push_binary(NodeKind::multiply);
+    }
+
+    FlatExpression::NodeIndex FlatExpression::root() const
+    {
+        if (!is_complete())
+            throw std::logic_error("Expression is not complete");
+
+        return open_subtrees_.front();
+    }
+
+    int evaluate(const FlatExpression& expr)
+    {
+        expr.root(); // throws for incomplete expressions
+
+        std::vector<int> values;
+
+        for (const auto& node : expr.nodes())
+        {
+            if (node.kind == NodeKind::integer)
+            {
+                values.push_back(node.value);
+                continue;
+            }
+
+            const int right = values.back();
+            values.pop_back();
+            int& left = values.back();
+
+            left = (node.kind == NodeKind::add) ? left + right : left * right;
+        }
+
+        return values.back();
+    }
+
+    namespace
+    {
+        // Iterative postorder walk of the tree: the visitor only classifies a node,
+        // the traversal itself is driven by an explicit stack of frames
+        class FlatteningVisitor : public AstVisitor
+        {
+            struct Frame
+            {
+                ExpressionNode* node;
+                NodeKind kind;
+                bool is_expanded; // children already scheduled - emit the operator
+            };
+
+            FlatExpression& expr_;
+            std::vector<Frame> frames_;
+
+            template <typename TBinaryNode>
+            void expand(TBinaryNode& node, NodeKind kind)
+            {
+                frames_.push_back(Frame{&node, kind, true});
+                frames_.push_back(Frame{&node.right(), NodeKind::integer, false});
+                frames_.push_back(Frame{&node.left(), NodeKind::integer, false});
+            }
+
+        public:
+            explicit FlatteningVisitor(FlatExpression& expr)
+                : expr_{expr}
+            {
+            }
+
+            void run(ExpressionNode& root)
+            {
+                frames_.push_back(Frame{&root, NodeKind::integer, false});
+
+                while (!frames_.empty())
+                {
+                    const Frame frame = frames_.back();
+                    frames_.pop_back();
+
+                    if (!frame.is_expanded)
+                        frame.node->accept(*this);
+                    else if (frame.kind == NodeKind::add)
+                        expr_.add();
+                    else
+                        expr_.multiply();
+                }
+            }
+
+            void visit(AddNode& node) override
+            {
+                expand(node, NodeKind::add);
+            }
+
+            void visit(MultiplyNode& node) override
+            {
+                expand(node, NodeKind::multiply);
+            }
+
+            void visit(IntNode& node) override
+            {
+                expr_.integer(node.value());
+            }
+
+            void visit(VariableNode&) override
+            {
+                throw std::invalid_argument("Variables are not supported by FlatExpression");
+            }
+        };
+    }
+
+    FlatExpression flatten(ExpressionNode& root)
+    {
+        FlatExpression expr;
+        FlatteningVisitor{expr}.run(root);
+
+        return expr;
+    }
+
+    ExpressionNodePtr to_tree(const FlatExpression& expr)
+    {
+        expr.root(); // throws for incomplete expressions
+
+        std::vector<ExpressionNodePtr> subtrees;
+
+        for (const auto& node : expr.nodes())
+        {
+            if (node.kind == NodeKind::integer)
+            {
+                subtrees.push_back(helpers::integer(node.value));
+                continue;
+            }
+
+            ExpressionNodePtr right = std::move(subtrees.back());
+            subtrees.pop_back();
+            ExpressionNodePtr& left = subtrees.back();
+
+            if (node.kind == NodeKind::add)
+                left = helpers::add(std::move(left), std::move(right));
+            else
+                left = helpers::multiply(std::move(left), std::move(right));
+        }
+
+        return std::move(subtrees.back());
+    }
+
+    void accept(const FlatExpression& expr, AstVisitor& visitor)
+    {
+        to_tree(expr)->accept(visitor);
+    }
+}
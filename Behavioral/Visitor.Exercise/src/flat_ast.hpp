@@ -0,0 +1,87 @@
+#ifndef FLAT_AST_HPP
+#define FLAT_AST_HPP
+
+#include "ast.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace AST
+{
+    enum class NodeKind : uint8_t
+    {
+        integer,
+        add,
+        multiply,
+        variable // not used by FlatExpression
+    };
+
+    // Expression stored in one contiguous array in postorder - children always precede their parent.
+    // Nodes are linked by indexes. The expression is built like an RPN program:
+    //   integer(3); integer(2); integer(5); multiply(); add();  // 3 + 2 * 5
+    // add()/multiply() combine the two most recently completed subtrees.
+    class FlatExpression
+    {
+    public:
+        using NodeIndex = uint32_t;
+
+        struct Node
+        {
+            NodeKind kind;
+            int value;       // integer only
+            NodeIndex left;  // add & multiply only
+            NodeIndex right; // add & multiply only
+        };
+
+    private:
+        std::vector<Node> nodes_;
+        std::vector<NodeIndex> open_subtrees_; // roots of subtrees not yet combined
+
+        NodeIndex push_binary(NodeKind kind);
+
+    public:
+        void reserve(size_t nodes_count);
+
+        NodeIndex integer(int value);
+        NodeIndex add();
+        NodeIndex multiply();
+
+        size_t size() const
+        {
+            return nodes_.size();
+        }
+
+        const Node& node(NodeIndex index) const
+        {
+            return nodes_[index];
+        }
+
+        const std::vector<Node>& nodes() const
+        {
+            return nodes_;
+        }
+
+        // the expression is complete when exactly one subtree is left
+        bool is_complete() const
+        {
+            return open_subtrees_.size() == 1;
+        }
+
+        NodeIndex root() const;
+    };
+
+    // explicit-stack evaluator - one pass over the array, no recursion
+    int evaluate(const FlatExpression& expr);
+
+    // conversions between representations - the conversions themselves are iterative, but the returned
+    // ExpressionNode tree is destroyed recursively (unique_ptr chain), so its depth is limited by the stack
+    FlatExpression flatten(ExpressionNode& root);
+    ExpressionNodePtr to_tree(const FlatExpression& expr);
+
+    // adapter for existing visitors: every call materializes the whole expression as a temporary
+    // ExpressionNode tree (allocation per node), visits it and destroys it recursively - the cost and
+    // depth limits of the pointer tree apply. Use evaluate() or keep the tree from to_tree() in hot paths.
+    void accept(const FlatExpression& expr, AstVisitor& visitor);
+}
+
+#endif // FLAT_AST_HPP
@@ -0,0 +1,240 @@
+#include "optimizer.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace AST
+{
+    void ConstantFoldingVisitor::set_integer(int value)
+    {
+        result_ = helpers::integer(value);
+        constant_ = value;
+    }
+
+    void ConstantFoldingVisitor::visit(AddNode& node)
+    {
+        ConstantFoldingVisitor lv, rv;
+        node.left().accept(lv);
+        node.right().accept(rv);
+
+        if (lv.constant() && rv.constant())
+            set_integer(*lv.constant() + *rv.constant());
+        else if (lv.constant() == 0)
+            *this = std::move(rv);
+        else if (rv.constant() == 0)
+            *this = std::move(lv);
+        else
+            result_ = helpers::add(lv.result(), rv.result());
+    }
+
+    void ConstantFoldingVisitor::visit(MultiplyNode& node)
+    {
+        ConstantFoldingVisitor lv, rv;
+        node.left().accept(lv);
+        node.right().accept(rv);
+
+        if (lv.constant() && rv.constant())
+            set_integer(*lv.constant() * *rv.constant());
+        else if (lv.constant() == 0 || rv.constant() == 0)
+            set_integer(0);
+        else if (lv.constant() == 1)
+            *this = std::move(rv);
+        else if (rv.constant() == 1)
+            *this = std::move(lv);
+        else
+            result_ = helpers::multiply(lv.result(), rv.result());
+    }
+
+    void ConstantFoldingVisitor::visit(IntNode& node)
+    {
+        set_integer(node.value());
+    }
+
+    void ConstantFoldingVisitor::visit(VariableNode& node)
+    {
+        result_ = helpers::variable(node.name());
+    }
+
+    ExpressionNodePtr fold_constants(ExpressionNode& expr)
+    {
+        ConstantFoldingVisitor folder;
+        expr.accept(folder);
+
+        return folder.result();
+    }
+
+    namespace
+    {
+        class NodeCountingVisitor : public AstVisitor
+        {
+            size_t count_ = 0;
+
+        public:
+            void visit(AddNode& node) override
+            {
+                ++count_;
+                node.left().accept(*this);
+                node.right().accept(*this);
+            }
+
+            void visit(MultiplyNode& node) override
+            {
+                ++count_;
+                node.left().accept(*this);
+                node.right().accept(*this);
+            }
+
+            void visit(IntNode&) override
+            {
+                ++count_;
+            }
+
+            void visit(VariableNode&) override
+            {
+                ++count_;
+            }
+
+            size_t count() const
+            {
+                return count_;
+            }
+        };
+
+        class DagBuildingVisitor : public AstVisitor
+        {
+            ExpressionDag& dag_;
+            ExpressionDag::NodeIndex index_ = 0; // node created for the last visited subtree
+
+        public:
+            explicit DagBuildingVisitor(ExpressionDag& dag)
+                : dag_{dag}
+            {
+            }
+
+            void visit(AddNode& node) override
+            {
+                node.left().accept(*this);
+                const auto left = index_;
+                node.right().accept(*this);
+                index_ = dag_.add(left, index_);
+            }
+
+            void visit(MultiplyNode& node) override
+            {
+                node.left().accept(*this);
+                const auto left = index_;
+                node.right().accept(*this);
+                index_ = dag_.multiply(left, index_);
+            }
+
+            void visit(IntNode& node) override
+            {
+                index_ = dag_.integer(node.value());
+            }
+
+            void visit(VariableNode& node) override
+            {
+                index_ = dag_.variable(node.name());
+            }
+
+            ExpressionDag::NodeIndex index() const
+            {
+                return index_;
+            }
+        };
+    }
+
+    size_t count_nodes(ExpressionNode& expr)
+    {
+        NodeCountingVisitor counter;
+        expr.accept(counter);
+
+        return counter.count();
+    }
+
+    size_t ExpressionDag::NodeHash::operator()(const Node& node) const
+    {
+        size_t hash = static_cast<size_t>(node.kind);
+        for (size_t part : {static_cast<size_t>(node.value), static_cast<size_t>(node.left), static_cast<size_t>(node.right)})
+            hash ^= std::hash<size_t>{}(part) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+
+        return hash;
+    }
+
+    ExpressionDag::NodeIndex ExpressionDag::intern(const Node& node)
+    {
+        auto [pos, is_inserted] = unique_nodes_.try_emplace(node, static_cast<NodeIndex>(nodes_.size()));
+        if (is_inserted)
+            nodes_.push_back(node);
+
+        return pos->second;
+    }
+
+    ExpressionDag::NodeIndex ExpressionDag::integer(int value)
+    {
+        return intern(Node{NodeKind::integer, value, 0, 0});
+    }
+
+    ExpressionDag::NodeIndex ExpressionDag::variable(const std::string& name)
+    {
+        auto pos = std::find(variables_.begin(), variables_.end(), name);
+        if (pos == variables_.end())
+            pos = variables_.insert(pos, name);
+
+        return intern(Node{NodeKind::variable, static_cast<int>(pos - variables_.begin()), 0, 0});
+    }
+
+    ExpressionDag::NodeIndex ExpressionDag::add(NodeIndex left, NodeIndex right)
+    {
+        return intern(Node{NodeKind::add, 0, std::min(left, right), std::max(left, right)});
+    }
+
+    ExpressionDag::NodeIndex ExpressionDag::multiply(NodeIndex left, NodeIndex right)
+    {
+        return intern(Node{NodeKind::multiply, 0, std::min(left, right), std::max(left, right)});
+    }
+
+    int ExpressionDag::evaluate(const Bindings& bindings) const
+    {
+        std::vector<int> variable_values;
+        variable_values.reserve(variables_.size());
+        for (const auto& name : variables_)
+            variable_values.push_back(bindings.at(name));
+
+        std::vector<int> values(nodes_.size());
+
+        for (size_t i = 0; i < nodes_.size(); ++i)
+        {
+            const Node& node = nodes_[i];
+
+            switch (node.kind)
+            {
+            case NodeKind::integer:
+                values[i] = node.value;
+                break;
+            case NodeKind::variable:
+                values[i] = variable_values[node.value];
+                break;
+            case NodeKind::add:
+                values[i] = values[node.left] + values[node.right];
+                break;
+            case NodeKind::multiply:
+                values[i] = values[node.left] * values[node.right];
+                break;
+            }
+        }
+
+        return values.at(root_);
+    }
+
+    ExpressionDag build_dag(ExpressionNode& expr)
+    {
+        ExpressionDag dag;
+
+        DagBuildingVisitor builder{dag};
+        expr.accept(builder);
+        dag.set_root(builder.index());
+
+        return dag;
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef OPTIMIZER_HPP
+#define OPTIMIZER_HPP
+
+#include "ast.hpp"
+#include "flat_ast.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AST
+{
+    // Rebuilds the expression with constant subtrees folded to integers
+    // and algebraic identities applied: x + 0 -> x, x * 1 -> x, x * 0 -> 0
+    class ConstantFoldingVisitor : public AstVisitor
+    {
+        ExpressionNodePtr result_;
+        std::optional<int> constant_; // value of result_ if it is an integer
+
+        void set_integer(int value);
+
+    public:
+        void visit(AddNode& node) override;
+        void visit(MultiplyNode& node) override;
+        void visit(IntNode& node) override;
+        void visit(VariableNode& node) override;
+
+        ExpressionNodePtr result()
+        {
+            return std::move(result_);
+        }
+
+        const std::optional<int>& constant() const
+        {
+            return constant_;
+        }
+    };
+
+    ExpressionNodePtr fold_constants(ExpressionNode& expr);
+
+    size_t count_nodes(ExpressionNode& expr);
+
+    // Expression as a DAG - identical subtrees are stored once (hash-consing).
+    // Operands of + and * are ordered canonically, so a + b and b + a share a node.
+    // Children are always created before parents, so evaluation is a single pass
+    // that computes every unique node once.
+    class ExpressionDag
+    {
+    public:
+        using NodeIndex = uint32_t;
+
+        struct Node
+        {
+            NodeKind kind;
+            int value; // integer - value; variable - slot
+            NodeIndex left;
+            NodeIndex right;
+
+            bool operator==(const Node& other) const
+            {
+                return kind == other.kind && value == other.value && left == other.left && right == other.right;
+            }
+        };
+
+    private:
+        struct NodeHash
+        {
+            size_t operator()(const Node& node) const;
+        };
+
+        std::vector<Node> nodes_;
+        std::vector<std::string> variables_; // slot -> name
+        std::unordered_map<Node, NodeIndex, NodeHash> unique_nodes_;
+        NodeIndex root_ = 0;
+
+        NodeIndex intern(const Node& node);
+
+    public:
+        NodeIndex integer(int value);
+        NodeIndex variable(const std::string& name);
+        NodeIndex add(NodeIndex left, NodeIndex right);
+        NodeIndex multiply(NodeIndex left, NodeIndex right);
+
+        void set_root(NodeIndex root)
+        {
+            root_ = root;
+        }
+
+        NodeIndex root() const
+        {
+            return root_;
+        }
+
+        size_t size() const
+        {
+            return nodes_.size();
+        }
+
+        const Node& node(NodeIndex index) const
+        {
+            return nodes_[index];
+        }
+
+        // throws std::out_of_range for unbound variables
+        int evaluate(const Bindings& bindings = {}) const;
+    };
+
+    ExpressionDag build_dag(ExpressionNode& expr);
+}
+
+#endif // OPTIMIZER_HPP
@@ -0,0 +1,288 @@
+#include "parallel_eval.hpp"
+#include "visitors.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace AST
+{
+    namespace
+    {
+        class SubtreeSizeVisitor : public AstVisitor
+        {
+            std::vector<uint32_t>& sizes_;
+
+            void visit_binary(ExpressionNode& left, ExpressionNode& right)
+            {
+                const size_t index = sizes_.size();
+                sizes_.push_back(0);
+                left.accept(*this);
+                right.accept(*this);
+                sizes_[index] = static_cast<uint32_t>(sizes_.size() - index);
+            }
+
+        public:
+            explicit SubtreeSizeVisitor(std::vector<uint32_t>& sizes)
+                : sizes_{sizes}
+            {
+            }
+
+            void visit(AddNode& node) override
+            {
+                visit_binary(node.left(), node.right());
+            }
+
+            void visit(MultiplyNode& node) override
+            {
+                visit_binary(node.left(), node.right());
+            }
+
+            void visit(IntNode&) override
+            {
+                sizes_.push_back(1);
+            }
+
+            void visit(VariableNode&) override
+            {
+                sizes_.push_back(1);
+            }
+        };
+    }
+
+    std::vector<uint32_t> subtree_sizes(ExpressionNode& root)
+    {
+        std::vector<uint32_t> sizes;
+        SubtreeSizeVisitor visitor{sizes};
+        root.accept(visitor);
+
+        if (sizes.size() > std::numeric_limits<uint32_t>::max())
+            throw std::length_error("Expression is too large");
+
+        return sizes;
+    }
+
+    class ParallelEvaluator::ForkingVisitor : public AstVisitor
+    {
+        ParallelEvaluator& evaluator_;
+        const size_t index_;
+        const size_t worker_;
+        int result_{};
+
+        template <typename TOperation>
+        void fork_join(ExpressionNode& left, ExpressionNode& right, TOperation operation)
+        {
+            const size_t left_index = index_ + 1;
+            Task right_task{&right, left_index + (*evaluator_.sizes_)[left_index]};
+            evaluator_.push(worker_, right_task);
+
+            // the right task must be joined before leaving this frame - even if the left subtree throws
+            int left_result{};
+            std::exception_ptr error;
+            try
+            {
+                left_result = evaluator_.evaluate_subtree(left, left_index, worker_);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            const int right_result = evaluator_.join(right_task, worker_);
+            if (error)
+                std::rethrow_exception(error);
+
+            result_ = operation(left_result, right_result);
+        }
+
+    public:
+        ForkingVisitor(ParallelEvaluator& evaluator, size_t index, size_t worker)
+            : evaluator_{evaluator}, index_{index}, worker_{worker}
+        {
+        }
+
+        void visit(AddNode& node) override
+        {
+            fork_join(node.left(), node.right(), [](int l, int r) { return l + r; });
+        }
+
+        void visit(MultiplyNode& node) override
+        {
+            fork_join(node.left(), node.right(), [](int l, int r) { return l * r; });
+        }
+
+        void visit(IntNode& node) override
+        {
+            result_ = node.value();
+        }
+
+        void visit(VariableNode& node) override
+        {
+            result_ = evaluator_.bindings_->at(node.name());
+        }
+
+        int result() const
+        {
+            return result_;
+        }
+    };
+
+    ParallelEvaluator::ParallelEvaluator(size_t threads_count, size_t fork_threshold)
+        : fork_threshold_{fork_threshold}
+    {
+        threads_count = std::max<size_t>(threads_count, 1);
+
+        for (size_t i = 0; i < threads_count; ++i)
+            workers_.push_back(std::make_unique<Worker>());
+
+        for (size_t i = 1; i < threads_count; ++i)
+            threads_.emplace_back([this, i] { worker_loop(i); });
+    }
+
+    ParallelEvaluator::~ParallelEvaluator()
+    {
+        {
+            std::lock_guard lk{mtx_};
+            is_stopped_ = true;
+        }
+        cv_.notify_all();
+
+        for (auto& thd : threads_)
+            thd.join();
+    }
+
+    void ParallelEvaluator::worker_loop(size_t worker)
+    {
+        while (true)
+        {
+            {
+                std::unique_lock lk{mtx_};
+                cv_.wait(lk, [this] { return is_stopped_ || is_active_; });
+                if (is_stopped_)
+                    return;
+            }
+
+            while (is_active_)
+            {
+                if (Task* task = steal(worker))
+                    execute(*task, worker);
+                else
+                    std::this_thread::yield();
+            }
+        }
+    }
+
+    void ParallelEvaluator::push(size_t worker, Task& task)
+    {
+        Worker& w = *workers_[worker];
+        std::lock_guard lk{w.mtx};
+        w.tasks.push_back(&task);
+    }
+
+    bool ParallelEvaluator::try_pop(size_t worker, Task& task)
+    {
+        Worker& w = *workers_[worker];
+        std::lock_guard lk{w.mtx};
+        if (w.tasks.empty() || w.tasks.back() != &task)
+            return false;
+
+        w.tasks.pop_back();
+        return true;
+    }
+
+    ParallelEvaluator::Task* ParallelEvaluator::steal(size_t thief)
+    {
+        for (size_t i = 1; i < workers_.size(); ++i)
+        {
+            Worker& victim = *workers_[(thief + i) % workers_.size()];
+            std::lock_guard lk{victim.mtx};
+            if (!victim.tasks.empty())
+            {
+                Task* task = victim.tasks.front();
+                victim.tasks.pop_front();
+                return task;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void ParallelEvaluator::execute(Task& task, size_t worker)
+    {
+        try
+        {
+            task.result = evaluate_subtree(*task.node, task.index, worker);
+        }
+        catch (...)
+        {
+            task.error = std::current_exception();
+        }
+
+        task.is_done.store(true, std::memory_order_release); // the task must not be touched after this store
+    }
+
+    int ParallelEvaluator::join(Task& task, size_t worker)
+    {
+        // tasks pushed after this one have already been joined - if the task was not stolen, it is on top of the deque
+        if (try_pop(worker, task))
+            execute(task, worker);
+
+        // the task was stolen - help other workers while waiting
+        while (!task.is_done.load(std::memory_order_acquire))
+        {
+            if (Task* stolen = steal(worker))
+                execute(*stolen, worker);
+            else
+                std::this_thread::yield();
+        }
+
+        if (task.error)
+            std::rethrow_exception(task.error);
+
+        return task.result;
+    }
+
+    int ParallelEvaluator::evaluate_subtree(ExpressionNode& node, size_t index, size_t worker)
+    {
+        if ((*sizes_)[index] < fork_threshold_)
+        {
+            ExprEvalVisitor evaluator{*bindings_};
+            node.accept(evaluator);
+            return evaluator.result();
+        }
+
+        ForkingVisitor visitor{*this, index, worker};
+        node.accept(visitor);
+        return visitor.result();
+    }
+
+    int ParallelEvaluator::evaluate(ExpressionNode& root, const std::vector<uint32_t>& sizes, const Bindings& bindings)
+    {
+        sizes_ = &sizes;
+        bindings_ = &bindings;
+
+        {
+            std::lock_guard lk{mtx_};
+            is_active_ = true;
+        }
+        cv_.notify_all();
+
+        struct Deactivate
+        {
+            ParallelEvaluator& evaluator;
+
+            ~Deactivate()
+            {
+                std::lock_guard lk{evaluator.mtx_};
+                evaluator.is_active_ = false;
+            }
+        } deactivate{*this};
+
+        return evaluate_subtree(root, 0, 0);
+    }
+
+    int ParallelEvaluator::evaluate(ExpressionNode& root, const Bindings& bindings)
+    {
+        return evaluate(root, subtree_sizes(root), bindings);
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef PARALLEL_EVAL_HPP
+#define PARALLEL_EVAL_HPP
+
+#include "ast.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AST
+{
+    // Sizes of all subtrees in preorder - for the node at index i
+    // the left child is at i + 1 and the right child at i + 1 + sizes[i + 1]
+    std::vector<uint32_t> subtree_sizes(ExpressionNode& root);
+
+    // Fork-join evaluator: subtrees of at least fork_threshold nodes are split -
+    // the right child is pushed to the deque of the current worker and the left one is evaluated in place.
+    // Idle workers steal the oldest (largest) tasks from other deques.
+    // Smaller subtrees are evaluated sequentially with ExprEvalVisitor.
+    // The calling thread takes part in the evaluation as worker 0.
+    class ParallelEvaluator
+    {
+        struct Task
+        {
+            ExpressionNode* node;
+            size_t index; // preorder index of the node
+            int result{};
+            std::exception_ptr error;
+            std::atomic<bool> is_done{false};
+
+            Task(ExpressionNode* node, size_t index)
+                : node{node}
+                , index{index}
+            {
+            }
+        };
+
+        struct Worker
+        {
+            std::mutex mtx;
+            std::deque<Task*> tasks;
+        };
+
+        class ForkingVisitor;
+
+        const size_t fork_threshold_;
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::vector<std::thread> threads_;
+
+        // state of the current evaluation
+        const std::vector<uint32_t>* sizes_ = nullptr;
+        const Bindings* bindings_ = nullptr;
+
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::atomic<bool> is_active_{false};
+        bool is_stopped_ = false;
+
+        void worker_loop(size_t worker);
+        void push(size_t worker, Task& task);
+        bool try_pop(size_t worker, Task& task);
+        Task* steal(size_t thief);
+        void execute(Task& task, size_t worker);
+        int join(Task& task, size_t worker);
+        int evaluate_subtree(ExpressionNode& node, size_t index, size_t worker);
+
+    public:
+        explicit ParallelEvaluator(size_t threads_count = std::thread::hardware_concurrency(), size_t fork_threshold = 10'000);
+        ParallelEvaluator(const ParallelEvaluator&) = delete;
+        ParallelEvaluator& operator=(const ParallelEvaluator&) = delete;
+        ~ParallelEvaluator();
+
+        size_t threads_count() const
+        {
+            return workers_.size();
+        }
+
+        // sizes must be computed by subtree_sizes() for the same tree;
+        // throws std::out_of_range for unbound variables.
+        // One evaluation at a time - evaluate() must not be called concurrently on the same evaluator
+        // (the workers share the state of the current evaluation); use one evaluator per calling thread.
+        int evaluate(ExpressionNode& root, const std::vector<uint32_t>& sizes, const Bindings& bindings = {});
+
+        int evaluate(ExpressionNode& root, const Bindings& bindings = {});
+    };
+}
+
+#endif // PARALLEL_EVAL_HPP
@@ -0,0 +1,145 @@
+#ifndef STATIC_AST_HPP
+#define STATIC_AST_HPP
+
+#include "ast.hpp"
+
+#include <type_traits>
+
+// Expression templates - the shape of an expression is encoded in its type:
+//   constexpr auto expr = add(integer(3), multiply(integer(2), integer(5)));  // AddExpr<IntExpr, MultiplyExpr<IntExpr, IntExpr>>
+// Evaluation is a chain of inline calls - constexpr at compile time, no virtual dispatch at runtime.
+namespace AST::static_expr
+{
+    class IntExpr
+    {
+        int value_;
+
+    public:
+        constexpr explicit IntExpr(int value)
+            : value_{value}
+        {
+        }
+
+        constexpr int evaluate() const
+        {
+            return value_;
+        }
+
+        ExpressionNodePtr to_tree() const
+        {
+            return helpers::integer(value_);
+        }
+    };
+
+    template <typename TLeft, typename TRight, typename TOperation>
+    class BinaryExpr
+    {
+        TLeft left_;
+        TRight right_;
+
+    public:
+        constexpr BinaryExpr(TLeft left, TRight right)
+            : left_{left}, right_{right}
+        {
+        }
+
+        constexpr const TLeft& left() const
+        {
+            return left_;
+        }
+
+        constexpr const TRight& right() const
+        {
+            return right_;
+        }
+
+        constexpr int evaluate() const
+        {
+            return TOperation{}(left_.evaluate(), right_.evaluate());
+        }
+
+        ExpressionNodePtr to_tree() const
+        {
+            return TOperation::make_node(left_.to_tree(), right_.to_tree());
+        }
+    };
+
+    struct AddOperation
+    {
+        constexpr int operator()(int left, int right) const
+        {
+            return left + right;
+        }
+
+        static ExpressionNodePtr make_node(ExpressionNodePtr left, ExpressionNodePtr right)
+        {
+            return helpers::add(std::move(left), std::move(right));
+        }
+    };
+
+    struct MultiplyOperation
+    {
+        constexpr int operator()(int left, int right) const
+        {
+            return left * right;
+        }
+
+        static ExpressionNodePtr make_node(ExpressionNodePtr left, ExpressionNodePtr right)
+        {
+            return helpers::multiply(std::move(left), std::move(right));
+        }
+    };
+
+    template <typename TLeft, typename TRight>
+    using AddExpr = BinaryExpr<TLeft, TRight, AddOperation>;
+
+    template <typename TLeft, typename TRight>
+    using MultiplyExpr = BinaryExpr<TLeft, TRight, MultiplyOperation>;
+
+    template <typename T>
+    struct IsStaticExpression : std::false_type
+    {
+    };
+
+    template <>
+    struct IsStaticExpression<IntExpr> : std::true_type
+    {
+    };
+
+    template <typename TLeft, typename TRight, typename TOperation>
+    struct IsStaticExpression<BinaryExpr<TLeft, TRight, TOperation>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    constexpr bool is_static_expression_v = IsStaticExpression<T>::value;
+
+    // builders mirroring AST::helpers
+    constexpr IntExpr integer(int value)
+    {
+        return IntExpr{value};
+    }
+
+    template <typename TLeft, typename TRight,
+        typename = std::enable_if_t<is_static_expression_v<TLeft> && is_static_expression_v<TRight>>>
+    constexpr AddExpr<TLeft, TRight> add(TLeft left, TRight right)
+    {
+        return AddExpr<TLeft, TRight>{left, right};
+    }
+
+    template <typename TLeft, typename TRight,
+        typename = std::enable_if_t<is_static_expression_v<TLeft> && is_static_expression_v<TRight>>>
+    constexpr MultiplyExpr<TLeft, TRight> multiply(TLeft left, TRight right)
+    {
+        return MultiplyExpr<TLeft, TRight>{left, right};
+    }
+
+    // conversion to the dynamic tree - e.g. for visitors
+    template <typename TExpr, typename = std::enable_if_t<is_static_expression_v<TExpr>>>
+    ExpressionNodePtr to_tree(const TExpr& expr)
+    {
+        return expr.to_tree();
+    }
+}
+
+#endif // STATIC_AST_HPP
@@ -0,0 +1,108 @@
+#ifndef STREAMING_PRINTER_HPP
+#define STREAMING_PRINTER_HPP
+
+#include "ast.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AST
+{
+    // Single-pass printer writing to an output iterator - output is identical to PrintingVisitor.
+    // Pending work is kept on an explicit stack (reused between calls), so deep trees are safe
+    // and no intermediate strings are created.
+    template <typename TOutputIterator>
+    class StreamingPrinter : public AstVisitor
+    {
+        struct Frame
+        {
+            ExpressionNode* node; // nullptr - emit text
+            std::string_view text;
+        };
+
+        TOutputIterator out_;
+        std::vector<Frame> frames_;
+
+        void write(std::string_view text)
+        {
+            out_ = std::copy(text.begin(), text.end(), out_);
+        }
+
+        void expand(ExpressionNode& left, ExpressionNode& right, std::string_view operator_text)
+        {
+            write("(");
+            frames_.push_back(Frame{nullptr, ")"});
+            frames_.push_back(Frame{&right, {}});
+            frames_.push_back(Frame{nullptr, operator_text});
+            frames_.push_back(Frame{&left, {}});
+        }
+
+    public:
+        explicit StreamingPrinter(TOutputIterator out)
+            : out_{out}
+        {
+        }
+
+        // returns the iterator past the last written character
+        TOutputIterator print(ExpressionNode& root)
+        {
+            frames_.push_back(Frame{&root, {}});
+
+            while (!frames_.empty())
+            {
+                const Frame frame = frames_.back();
+                frames_.pop_back();
+
+                if (frame.node)
+                    frame.node->accept(*this);
+                else
+                    write(frame.text);
+            }
+
+            return out_;
+        }
+
+        void visit(AddNode& node) override
+        {
+            expand(node.left(), node.right(), " + ");
+        }
+
+        void visit(MultiplyNode& node) override
+        {
+            expand(node.left(), node.right(), " * ");
+        }
+
+        void visit(IntNode& node) override
+        {
+            char buffer[16];
+            const auto [end, error] = std::to_chars(std::begin(buffer), std::end(buffer), node.value());
+            write(std::string_view(buffer, end - buffer));
+        }
+
+        void visit(VariableNode& node) override
+        {
+            write(node.name());
+        }
+    };
+
+    // appends the expression to buffer
+    inline void print(ExpressionNode& root, std::string& buffer)
+    {
+        StreamingPrinter printer{std::back_inserter(buffer)};
+        printer.print(root);
+    }
+
+    inline std::string print(ExpressionNode& root)
+    {
+        std::string buffer;
+        print(root, buffer);
+
+        return buffer;
+    }
+}
+
+#endif // STREAMING_PRINTER_HPP
@@ -0,0 +1,183 @@
+#include "variant_ast.hpp"
+
+#include <charconv>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+namespace AST::cpp17
+{
+    NodeIndex Expression::push(Node node)
+    {
+        const auto index = static_cast<NodeIndex>(nodes_.size());
+        nodes_.push_back(node);
+
+        return index;
+    }
+
+    void Expression::reserve(size_t nodes_count)
+    {
+        nodes_.reserve(nodes_count);
+    }
+
+    NodeIndex Expression::integer(int value)
+    {
+        return push(Int{value});
+    }
+
+    NodeIndex Expression::add(NodeIndex left, NodeIndex right)
+    {
+        if (left >= nodes_.size() || right >= nodes_.size())
+            throw std::out_of_range("Operand does not exist");
+
+        return push(Add{left, right});
+    }
+
+    NodeIndex Expression::multiply(NodeIndex left, NodeIndex right)
+    {
+        if (left >= nodes_.size() || right >= nodes_.size())
+            throw std::out_of_range("Operand does not exist");
+
+        return push(Multiply{left, right});
+    }
+
+    NodeIndex Expression::root() const
+    {
+        if (nodes_.empty())
+            throw std::logic_error("Expression is empty");
+
+        return static_cast<NodeIndex>(nodes_.size() - 1);
+    }
+
+    int evaluate(const Expression& expr)
+    {
+        const NodeIndex root = expr.root();
+
+        std::vector<int> values(expr.size());
+
+        auto evaluator = overloaded{
+            [](const Int& node) { return node.value; },
+            [&values](const Add& node) { return values[node.left] + values[node.right]; },
+            [&values](const Multiply& node) { return values[node.left] * values[node.right]; }};
+
+        for (size_t i = 0; i < expr.size(); ++i)
+            values[i] = std::visit(evaluator, expr.node(static_cast<NodeIndex>(i)));
+
+        return values[root];
+    }
+
+    std::string print(const Expression& expr)
+    {
+        struct Frame
+        {
+            NodeIndex index;
+            std::string_view text; // not empty - emit text instead of the node
+        };
+
+        std::string result;
+        std::vector<Frame> frames{Frame{expr.root(), {}}};
+
+        auto expand = [&](NodeIndex left, NodeIndex right, std::string_view operator_text) {
+            result += '(';
+            frames.push_back(Frame{0, ")"});
+            frames.push_back(Frame{right, {}});
+            frames.push_back(Frame{0, operator_text});
+            frames.push_back(Frame{left, {}});
+        };
+
+        auto printer = overloaded{
+            [&result](const Int& node) {
+                char buffer[16];
+                const auto [end, error] = std::to_chars(std::begin(buffer), std::end(buffer), node.value);
+                result.append(buffer, end);
+            },
+            [&expand](const Add& node) { expand(node.left, node.right, " + "); },
+            [&expand](const Multiply& node) { expand(node.left, node.right, " * "); }};
+
+        while (!frames.empty())
+        {
+            const Frame frame = frames.back();
+            frames.pop_back();
+
+            if (frame.text.empty())
+                std::visit(printer, expr.node(frame.index));
+            else
+                result += frame.text;
+        }
+
+        return result;
+    }
+
+    namespace
+    {
+        class ConvertingVisitor : public AstVisitor
+        {
+            Expression& expr_;
+            NodeIndex index_ = 0; // node created for the last visited subtree
+
+        public:
+            explicit ConvertingVisitor(Expression& expr)
+                : expr_{expr}
+            {
+            }
+
+            void visit(AddNode& node) override
+            {
+                node.left().accept(*this);
+                const NodeIndex left = index_;
+                node.right().accept(*this);
+                index_ = expr_.add(left, index_);
+            }
+
+            void visit(MultiplyNode& node) override
+            {
+                node.left().accept(*this);
+                const NodeIndex left = index_;
+                node.right().accept(*this);
+                index_ = expr_.multiply(left, index_);
+            }
+
+            void visit(IntNode& node) override
+            {
+                index_ = expr_.integer(node.value());
+            }
+
+            void visit(VariableNode&) override
+            {
+                throw std::invalid_argument("Variables are not supported by cpp17::Expression");
+            }
+        };
+    }
+
+    Expression from_tree(ExpressionNode& root)
+    {
+        Expression expr;
+        ConvertingVisitor converter{expr};
+        root.accept(converter);
+
+        return expr;
+    }
+
+    ExpressionNodePtr to_tree(const Expression& expr)
+    {
+        const NodeIndex root = expr.root();
+
+        std::vector<ExpressionNodePtr> subtrees(expr.size());
+
+        auto take = [&subtrees](NodeIndex index) {
+            if (!subtrees[index])
+                throw std::logic_error("Node is shared by many parents");
+            return std::move(subtrees[index]);
+        };
+
+        auto converter = overloaded{
+            [](const Int& node) { return ExpressionNodePtr{helpers::integer(node.value)}; },
+            [&take](const Add& node) { return ExpressionNodePtr{helpers::add(take(node.left), take(node.right))}; },
+            [&take](const Multiply& node) { return ExpressionNodePtr{helpers::multiply(take(node.left), take(node.right))}; }};
+
+        for (size_t i = 0; i < expr.size(); ++i)
+            subtrees[i] = std::visit(converter, expr.node(static_cast<NodeIndex>(i)));
+
+        return take(root);
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef VARIANT_AST_HPP
+#define VARIANT_AST_HPP
+
+#include "ast.hpp"
+
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+// Closed hierarchy of nodes - std::variant instead of virtual functions.
+// Operations are dispatched at compile time with std::visit and overloaded lambdas.
+namespace AST::cpp17
+{
+    template <typename... Ts>
+    struct overloaded : Ts...
+    {
+        using Ts::operator()...;
+    };
+
+    template <typename... Ts>
+    overloaded(Ts...) -> overloaded<Ts...>;
+
+    using NodeIndex = uint32_t;
+
+    struct Int
+    {
+        int value;
+    };
+
+    struct Add
+    {
+        NodeIndex left;
+        NodeIndex right;
+    };
+
+    struct Multiply
+    {
+        NodeIndex left;
+        NodeIndex right;
+    };
+
+    using Node = std::variant<Int, Add, Multiply>;
+
+    // Nodes stored in a vector - children always precede their parent, the last node is the root
+    class Expression
+    {
+        std::vector<Node> nodes_;
+
+        NodeIndex push(Node node);
+
+    public:
+        void reserve(size_t nodes_count);
+
+        NodeIndex integer(int value);
+        // throws std::out_of_range if operands do not exist yet
+        NodeIndex add(NodeIndex left, NodeIndex right);
+        NodeIndex multiply(NodeIndex left, NodeIndex right);
+
+        size_t size() const
+        {
+            return nodes_.size();
+        }
+
+        const Node& node(NodeIndex index) const
+        {
+            return nodes_[index];
+        }
+
+        const std::vector<Node>& nodes() const
+        {
+            return nodes_;
+        }
+
+        // throws std::logic_error for empty expressions
+        NodeIndex root() const;
+    };
+
+    // one pass over the vector - operands are evaluated before their parent
+    int evaluate(const Expression& expr);
+
+    // output is identical to PrintingVisitor; iterative, so deep expressions are safe
+    std::string print(const Expression& expr);
+
+    // conversions from/to the virtual hierarchy;
+    // from_tree throws std::invalid_argument for variables, to_tree throws std::logic_error for shared nodes
+    Expression from_tree(ExpressionNode& root);
+    ExpressionNodePtr to_tree(const Expression& expr);
+}
+
+#endif // VARIANT_AST_HPP
@@ -5,12 +5,22 @@
 
 class ExprEvalVisitor : public AST::AstVisitor
 {
+    inline static const AST::Bindings no_bindings_{};
+
+    const AST::Bindings* bindings_;
     int result_{};
 
 public:
+    // bindings are referenced, not copied - they must outlive the visitor
+    explicit ExprEvalVisitor(const AST::Bindings& bindings = no_bindings_) : bindings_{&bindings}
+    {
+    }
+
+    ExprEvalVisitor(AST::Bindings&&) = delete; // a temporary would dangle
+
     void visit(AST::AddNode& node)
     {
-        ExprEvalVisitor lv, rv;
+        ExprEvalVisitor lv{*bindings_}, rv{*bindings_};
         node.left().accept(lv);
         node.right().accept(rv);
         result_ = lv.result() + rv.result();
@@ -18,7 +28,7 @@ public:
 
     void visit(AST::MultiplyNode& node)
     {
-        ExprEvalVisitor lv, rv;
+        ExprEvalVisitor lv{*bindings_}, rv{*bindings_};
         node.left().accept(lv);
         node.right().accept(rv);
         result_ = lv.result() * rv.result();
@@ -29,6 +39,12 @@ public:
         result_ = node.value();
     }
 
+    // throws std::out_of_range for unbound variables
+    void visit(AST::VariableNode& node)
+    {
+        result_ = bindings_->at(node.name());
+    }
+
     int result() const
     {
         return result_;
@@ -45,6 +61,11 @@ public:
         result_ = std::to_string(node.value());
     }
 
+    void visit(AST::VariableNode& node)
+    {
+        result_ = node.name();
+    }
+
     void visit(AST::AddNode& node)
     {
         PrintingVisitor lv, rv;
@@ -0,0 +1,103 @@
+#include "bytecode.hpp"
+#include "visitors.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace AST;
+using namespace AST::helpers;
+
+TEST_CASE("variables in expression visitors", "[ast]")
+{
+    auto expr = add(variable("x"), multiply(integer(2), variable("y")));
+
+    SECTION("evaluation uses bindings")
+    {
+        Bindings bindings{{"x", 3}, {"y", 5}};
+        ExprEvalVisitor evaluator{bindings};
+        expr->accept(evaluator);
+
+        REQUIRE(evaluator.result() == 13);
+    }
+
+    SECTION("bindings cannot be temporary nor implicitly converted")
+    {
+        static_assert(!std::is_constructible_v<ExprEvalVisitor, Bindings&&>);
+        static_assert(!std::is_convertible_v<const Bindings&, ExprEvalVisitor>);
+    }
+
+    SECTION("unbound variable throws")
+    {
+        ExprEvalVisitor evaluator;
+
+        REQUIRE_THROWS_AS(expr->accept(evaluator), std::out_of_range);
+    }
+
+    SECTION("printing")
+    {
+        PrintingVisitor printer;
+        expr->accept(printer);
+
+        REQUIRE(printer.str() == "(x + (2 * y))");
+    }
+}
+
+TEST_CASE("bytecode compiler", "[bytecode]")
+{
+    SECTION("postorder code")
+    {
+        auto expr = add(integer(3), multiply(integer(2), integer(5)));
+        Program program = compile(*expr);
+
+        REQUIRE(program.code().size() == 5);
+        REQUIRE(program.code()[0].op == OpCode::push_int);
+        REQUIRE(program.code()[3].op == OpCode::multiply);
+        REQUIRE(program.code()[4].op == OpCode::add);
+        REQUIRE(program.max_stack_depth() == 3);
+    }
+
+    SECTION("every variable gets one slot")
+    {
+        auto expr = add(variable("x"), multiply(variable("y"), variable("x")));
+        Program program = compile(*expr);
+
+        REQUIRE(program.variables() == std::vector<std::string>{"x", "y"});
+        REQUIRE(program.variable_slot("y") == 1);
+        REQUIRE(program.variable_slot("z") == Program::npos);
+    }
+}
+
+TEST_CASE("virtual machine", "[bytecode]")
+{
+    VirtualMachine vm;
+
+    SECTION("constant expression")
+    {
+        auto expr = add(integer(3), multiply(integer(2), integer(5)));
+
+        REQUIRE(vm.run(compile(*expr)) == 13);
+    }
+
+    SECTION("compiled expression is rerun with new bindings")
+    {
+        auto expr = add(variable("x"), multiply(integer(2), variable("y")));
+        Program program = compile(*expr);
+
+        for (int x = -5; x <= 5; ++x)
+        {
+            Bindings bindings{{"x", x}, {"y", x * x}};
+
+            ExprEvalVisitor evaluator{bindings};
+            expr->accept(evaluator);
+
+            REQUIRE(vm.run(program, program.bind(bindings)) == evaluator.result());
+        }
+    }
+
+    SECTION("missing variable values throw")
+    {
+        auto expr = variable("x");
+
+        REQUIRE_THROWS_AS(vm.run(compile(*expr)), std::invalid_argument);
+    }
+}
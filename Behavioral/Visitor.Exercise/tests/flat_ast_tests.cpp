@@ -0,0 +1,87 @@
+#include "flat_ast.hpp"
+#include "visitors.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+
+using namespace AST;
+using namespace AST::helpers;
+
+TEST_CASE("flat expression", "[flat_ast]")
+{
+    FlatExpression expr;
+
+    SECTION("integer")
+    {
+        expr.integer(4);
+
+        REQUIRE(evaluate(expr) == 4);
+    }
+
+    SECTION("nodes are stored in postorder")
+    {
+        expr.integer(3);
+        expr.integer(2);
+        expr.integer(5);
+        expr.multiply();
+        auto root = expr.add();
+
+        REQUIRE(expr.root() == root);
+        REQUIRE(expr.node(root).kind == NodeKind::add);
+        REQUIRE(expr.node(root).left == 0);
+        REQUIRE(expr.node(root).right == 3);
+        REQUIRE(evaluate(expr) == 13);
+    }
+
+    SECTION("binary node without operands throws")
+    {
+        expr.integer(1);
+
+        REQUIRE_THROWS_AS(expr.add(), std::logic_error);
+    }
+
+    SECTION("incomplete expression cannot be evaluated")
+    {
+        expr.integer(1);
+        expr.integer(2);
+
+        REQUIRE_THROWS_AS(evaluate(expr), std::logic_error);
+    }
+
+    SECTION("deep expression is evaluated without recursion")
+    {
+        expr.integer(0);
+        for (int i = 0; i < 1'000'000; ++i)
+        {
+            expr.integer(1);
+            expr.add();
+        }
+
+        REQUIRE(evaluate(expr) == 1'000'000);
+    }
+}
+
+TEST_CASE("conversions between tree and flat expression", "[flat_ast]")
+{
+    auto tree = add(integer(3), multiply(add(integer(2), integer(4)), integer(5)));
+
+    FlatExpression expr = flatten(*tree);
+
+    REQUIRE(expr.size() == 7);
+    REQUIRE(evaluate(expr) == 33);
+
+    SECTION("existing visitors work through the adapter")
+    {
+        PrintingVisitor printer;
+        accept(expr, printer);
+
+        REQUIRE(printer.str() == "(3 + ((2 + 4) * 5))");
+    }
+
+    SECTION("round trip")
+    {
+        ExprEvalVisitor evaluator;
+        to_tree(expr)->accept(evaluator);
+
+        REQUIRE(evaluator.result() == 33);
+    }
+}
@@ -0,0 +1,86 @@
+#include "optimizer.hpp"
+#include "visitors.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace AST;
+using namespace AST::helpers;
+
+namespace
+{
+    std::string to_string(ExpressionNode& expr)
+    {
+        PrintingVisitor printer;
+        expr.accept(printer);
+        return printer.str();
+    }
+}
+
+TEST_CASE("constant folding", "[optimizer]")
+{
+    SECTION("constant subtrees are folded")
+    {
+        auto expr = add(variable("x"), multiply(integer(2), add(integer(1), integer(4))));
+
+        REQUIRE(to_string(*fold_constants(*expr)) == "(x + 10)");
+    }
+
+    SECTION("x + 0 and 0 + x")
+    {
+        auto expr = add(integer(0), add(variable("x"), integer(0)));
+
+        REQUIRE(to_string(*fold_constants(*expr)) == "x");
+    }
+
+    SECTION("x * 1 and 1 * x")
+    {
+        auto expr = multiply(integer(1), multiply(variable("x"), add(integer(0), integer(1))));
+
+        REQUIRE(to_string(*fold_constants(*expr)) == "x");
+    }
+
+    SECTION("x * 0")
+    {
+        auto expr = add(variable("y"), multiply(variable("x"), integer(0)));
+
+        REQUIRE(to_string(*fold_constants(*expr)) == "y");
+    }
+
+    SECTION("node count")
+    {
+        auto expr = add(integer(1), multiply(integer(2), variable("x")));
+
+        REQUIRE(count_nodes(*expr) == 5);
+    }
+}
+
+TEST_CASE("expression DAG", "[optimizer]")
+{
+    SECTION("identical subtrees are shared")
+    {
+        auto expr = multiply(add(variable("x"), integer(2)), add(variable("x"), integer(2)));
+        ExpressionDag dag = build_dag(*expr);
+
+        REQUIRE(count_nodes(*expr) == 7);
+        REQUIRE(dag.size() == 4); // x, 2, x + 2, (x + 2) * (x + 2)
+        REQUIRE(dag.node(dag.root()).left == dag.node(dag.root()).right);
+    }
+
+    SECTION("operands of commutative operators are canonicalized")
+    {
+        auto expr = add(multiply(variable("a"), variable("b")), multiply(variable("b"), variable("a")));
+
+        REQUIRE(build_dag(*expr).size() == 4);
+    }
+
+    SECTION("evaluation matches ExprEvalVisitor")
+    {
+        auto expr = add(multiply(add(variable("x"), integer(3)), variable("y")), multiply(variable("y"), add(integer(3), variable("x"))));
+        Bindings bindings{{"x", 4}, {"y", -2}};
+
+        ExprEvalVisitor evaluator{bindings};
+        expr->accept(evaluator);
+
+        REQUIRE(build_dag(*expr).evaluate(bindings) == evaluator.result());
+        REQUIRE(build_dag(*fold_constants(*expr)).evaluate(bindings) == evaluator.result());
+    }
+}
@@ -0,0 +1,71 @@
+#include "parallel_eval.hpp"
+#include "visitors.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <stdexcept>
+
+using namespace AST;
+using namespace AST::helpers;
+
+namespace
+{
+    ExpressionNodePtr random_tree(size_t nodes_count, std::mt19937_64& rnd)
+    {
+        if (nodes_count == 1)
+            return rnd() % 3 == 0 ? variable("x") : integer(static_cast<int>(rnd() % 10));
+
+        const size_t children_count = nodes_count - 1;
+        const size_t left_count = 2 * (rnd() % (children_count / 2)) + 1;
+
+        auto left = random_tree(left_count, rnd);
+        auto right = random_tree(children_count - left_count, rnd);
+
+        if (left_count == 1 && children_count - left_count == 1)
+            return multiply(std::move(left), std::move(right));
+        return add(std::move(left), std::move(right));
+    }
+}
+
+TEST_CASE("subtree sizes", "[parallel_eval]")
+{
+    auto expr = add(multiply(integer(1), integer(2)), variable("x"));
+
+    REQUIRE(subtree_sizes(*expr) == std::vector<uint32_t>{5, 3, 1, 1, 1});
+}
+
+TEST_CASE("parallel evaluation", "[parallel_eval]")
+{
+    std::mt19937_64 rnd{42};
+    auto expr = random_tree(20'001, rnd);
+    Bindings bindings{{"x", 3}};
+
+    ExprEvalVisitor evaluator{bindings};
+    expr->accept(evaluator);
+
+    SECTION("results match ExprEvalVisitor")
+    {
+        for (size_t threads_count : {1, 2, 4})
+            for (size_t fork_threshold : {1, 16, 1'000, 100'000})
+            {
+                ParallelEvaluator parallel{threads_count, fork_threshold};
+                REQUIRE(parallel.evaluate(*expr, bindings) == evaluator.result());
+            }
+    }
+
+    SECTION("evaluator can be reused")
+    {
+        ParallelEvaluator parallel{4, 64};
+        const auto sizes = subtree_sizes(*expr);
+
+        for (int i = 0; i < 10; ++i)
+            REQUIRE(parallel.evaluate(*expr, sizes, bindings) == evaluator.result());
+    }
+
+    SECTION("unbound variable")
+    {
+        ParallelEvaluator parallel{4, 16};
+
+        REQUIRE_THROWS_AS(parallel.evaluate(*expr), std::out_of_range);
+        REQUIRE(parallel.evaluate(*expr, bindings) == evaluator.result());
+    }
+}
@@ -0,0 +1,51 @@
+#include "static_ast.hpp"
+#include "visitors.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <type_traits>
+
+using namespace AST;
+
+TEST_CASE("static expression", "[static_ast]")
+{
+    using namespace AST::static_expr;
+
+    SECTION("shape is encoded in type")
+    {
+        constexpr auto expr = add(integer(3), multiply(integer(2), integer(5)));
+
+        static_assert(std::is_same_v<std::decay_t<decltype(expr)>, AddExpr<IntExpr, MultiplyExpr<IntExpr, IntExpr>>>);
+    }
+
+    SECTION("evaluated at compile time")
+    {
+        constexpr auto expr = multiply(add(integer(1), integer(2)), add(integer(-3), integer(10)));
+
+        static_assert(expr.evaluate() == 21);
+    }
+
+    SECTION("evaluated at runtime")
+    {
+        int value = 4;
+        auto expr = add(integer(value), multiply(integer(value), integer(2)));
+
+        REQUIRE(expr.evaluate() == 12);
+    }
+}
+
+TEST_CASE("conversion of static expression to tree", "[static_ast]")
+{
+    constexpr auto expr = static_expr::add(static_expr::integer(3), static_expr::multiply(static_expr::integer(2), static_expr::integer(5)));
+    auto tree = static_expr::to_tree(expr);
+
+    auto expected = helpers::add(helpers::integer(3), helpers::multiply(helpers::integer(2), helpers::integer(5)));
+    PrintingVisitor expected_printer;
+    expected->accept(expected_printer);
+
+    PrintingVisitor printer;
+    tree->accept(printer);
+    ExprEvalVisitor evaluator;
+    tree->accept(evaluator);
+
+    REQUIRE(printer.str() == expected_printer.str());
+    REQUIRE(evaluator.result() == expr.evaluate());
+}
@@ -0,0 +1,63 @@
+#include "streaming_printer.hpp"
+#include "visitors.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <climits>
+#include <sstream>
+
+using namespace AST;
+using namespace AST::helpers;
+
+namespace
+{
+    std::string print_with_visitor(ExpressionNode& expr)
+    {
+        PrintingVisitor printer;
+        expr.accept(printer);
+        return printer.str();
+    }
+}
+
+TEST_CASE("streaming printer", "[streaming_printer]")
+{
+    SECTION("output is identical to PrintingVisitor")
+    {
+        auto expr = add(multiply(integer(-12), variable("x")), add(integer(INT_MIN), multiply(integer(0), integer(INT_MAX))));
+
+        REQUIRE(print(*expr) == print_with_visitor(*expr));
+    }
+
+    SECTION("appends to buffer")
+    {
+        auto expr = multiply(integer(2), variable("y"));
+        std::string buffer = "expr: ";
+        print(*expr, buffer);
+
+        REQUIRE(buffer == "expr: (2 * y)");
+    }
+
+    SECTION("writes to output iterator")
+    {
+        auto expr = add(integer(1), integer(2));
+        std::ostringstream out;
+        StreamingPrinter printer{std::ostreambuf_iterator<char>(out)};
+        printer.print(*expr);
+        printer.print(*expr);
+
+        REQUIRE(out.str() == "(1 + 2)(1 + 2)");
+    }
+
+    SECTION("deep tree")
+    {
+        constexpr int depth = 20'000; // limited by the recursive destruction of the tree
+
+        ExpressionNodePtr expr = integer(0);
+        for (int i = 1; i <= depth; ++i)
+            expr = add(std::move(expr), integer(i % 10));
+
+        const std::string text = print(*expr);
+
+        REQUIRE(text.size() == 1 + depth * std::string{"( + 1)"}.size());
+        REQUIRE(text.substr(depth - 2, 12) == "((0 + 1) + 2");
+        REQUIRE(text.substr(text.size() - 12) == "8) + 9) + 0)");
+    }
+}
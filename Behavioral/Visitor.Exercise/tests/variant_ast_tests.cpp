@@ -0,0 +1,85 @@
+#include "variant_ast.hpp"
+#include "visitors.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+
+using namespace AST;
+
+TEST_CASE("variant based expression", "[variant_ast]")
+{
+    cpp17::Expression expr;
+
+    SECTION("evaluate")
+    {
+        const auto two = expr.integer(2);
+        expr.add(expr.integer(3), expr.multiply(two, expr.integer(5)));
+
+        REQUIRE(cpp17::evaluate(expr) == 13);
+    }
+
+    SECTION("print")
+    {
+        expr.multiply(expr.add(expr.integer(-1), expr.integer(2)), expr.integer(7));
+
+        REQUIRE(cpp17::print(expr) == "((-1 + 2) * 7)");
+    }
+
+    SECTION("operands must exist")
+    {
+        expr.integer(1);
+
+        REQUIRE_THROWS_AS(expr.add(0, 1), std::out_of_range);
+    }
+
+    SECTION("empty expression")
+    {
+        REQUIRE_THROWS_AS(cpp17::evaluate(expr), std::logic_error);
+    }
+}
+
+TEST_CASE("conversions between virtual and variant based expressions", "[variant_ast]")
+{
+    using namespace AST::helpers;
+
+    auto tree = add(multiply(integer(4), add(integer(1), integer(2))), multiply(integer(-3), integer(5)));
+
+    PrintingVisitor printer;
+    tree->accept(printer);
+    ExprEvalVisitor evaluator;
+    tree->accept(evaluator);
+
+    SECTION("from tree")
+    {
+        const cpp17::Expression expr = cpp17::from_tree(*tree);
+
+        REQUIRE(expr.size() == 9);
+        REQUIRE(cpp17::print(expr) == printer.str());
+        REQUIRE(cpp17::evaluate(expr) == evaluator.result());
+    }
+
+    SECTION("round trip")
+    {
+        auto converted = cpp17::to_tree(cpp17::from_tree(*tree));
+
+        PrintingVisitor converted_printer;
+        converted->accept(converted_printer);
+
+        REQUIRE(converted_printer.str() == printer.str());
+    }
+
+    SECTION("variables are not supported")
+    {
+        auto expr = add(integer(1), variable("x"));
+
+        REQUIRE_THROWS_AS(cpp17::from_tree(*expr), std::invalid_argument);
+    }
+
+    SECTION("shared nodes cannot be converted to tree")
+    {
+        cpp17::Expression expr;
+        const auto one = expr.integer(1);
+        expr.add(one, one);
+
+        REQUIRE_THROWS_AS(cpp17::to_tree(expr), std::logic_error);
+    }
+}
@@ -1,10 +0,0 @@
-#include "circle.hpp"
-#include "shape_factories.hpp"
-
-using namespace std;
-using namespace Drawing;
-
-namespace 
-{
-    bool is_registered = SingletonShapeFactory::instance().register_creator(Circle::id, []() { return make_unique<Circle>(); });
-}
@@ -1,27 +1,136 @@
 #ifndef GENERIC_FACTORY_HPP
 #define GENERIC_FACTORY_HPP
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 template <typename ProductType, typename IdType = std::string, typename CreatorType = std::function<std::unique_ptr<ProductType>()>>
 class GenericFactory
 {
-    std::unordered_map<IdType, CreatorType> creators_;
-
 public:
-    bool register_creator(IdType id, CreatorType creator)
+    // std::unique_ptr<ProductType> for default creators, a smart pointer with a custom deleter for pooled ones
+    using ProductPtr = decltype(std::declval<const CreatorType&>()());
+    using CreatorFunction = ProductPtr (*)();
+
+private:
+    // captureless creators are kept as plain function pointers - called without std::function overhead
+    struct Creator
+    {
+        CreatorFunction function = nullptr;
+        std::optional<CreatorType> creator; // stateful creators only
+
+        ProductPtr operator()() const
+        {
+            return function ? function() : (*creator)();
+        }
+    };
+
+    // the direct-index table is built only for dense ids - at most this many slots per registered creator
+    static constexpr std::size_t max_slots_per_creator = 4;
+
+    std::unordered_map<IdType, Creator> creators_;
+    std::vector<std::pair<IdType, Creator>> frozen_creators_; // sorted by id
+    std::vector<std::uint32_t> indexed_creators_;             // dense unsigned ids only - position id holds index into frozen_creators_
+    static constexpr std::uint32_t no_creator = std::numeric_limits<std::uint32_t>::max();
+    static constexpr bool has_integral_ids = std::is_unsigned_v<IdType> && !std::is_same_v<IdType, bool>;
+    bool is_frozen_ = false;
+
+    bool insert(IdType id, Creator creator)
     {
+        if (is_frozen_)
+            throw std::logic_error("Factory is frozen - creators cannot be registered");
+
         bool is_inserted;
         std::tie(std::ignore, is_inserted) = creators_.insert(std::make_pair(std::move(id), std::move(creator)));
 
         return is_inserted;
     }
 
-    std::unique_ptr<ProductType> create(const IdType& id) const
+public:
+    bool register_creator(IdType id, CreatorType creator)
+    {
+        if constexpr (std::is_convertible_v<const CreatorType&, CreatorFunction>)
+            return insert(std::move(id), Creator{creator, std::nullopt});
+        else
+            return insert(std::move(id), Creator{nullptr, std::move(creator)});
+    }
+
+    // captureless lambdas & functions
+    template <typename TCreator, typename = std::enable_if_t<!std::is_same_v<std::decay_t<TCreator>, CreatorType> && std::is_convertible_v<TCreator, CreatorFunction>>>
+    bool register_creator(IdType id, TCreator&& creator)
+    {
+        return insert(std::move(id), Creator{static_cast<CreatorFunction>(creator), std::nullopt});
+    }
+
+    // Moves all creators into an immutable table sorted by id.
+    // After freeze() the factory is read-only - create() may be called from many threads
+    // without locking, provided that freeze() happens-before those threads are started.
+    void freeze()
+    {
+        if (is_frozen_)
+            return;
+
+        frozen_creators_.reserve(creators_.size());
+        for (auto& [id, creator] : creators_)
+            frozen_creators_.emplace_back(id, std::move(creator));
+        creators_.clear();
+
+        std::sort(frozen_creators_.begin(), frozen_creators_.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        // dense unsigned ids (e.g. interned symbols) are resolved with a single array index;
+        // sparse ids (hashes, 64-bit keys) keep the binary search
+        if constexpr (has_integral_ids)
+        {
+            if (!frozen_creators_.empty() && frozen_creators_.back().first / max_slots_per_creator < frozen_creators_.size())
+            {
+                indexed_creators_.assign(static_cast<std::size_t>(frozen_creators_.back().first) + 1, no_creator);
+                for (std::size_t i = 0; i < frozen_creators_.size(); ++i)
+                    indexed_creators_[static_cast<std::size_t>(frozen_creators_[i].first)] = static_cast<std::uint32_t>(i);
+            }
+        }
+
+        is_frozen_ = true;
+    }
+
+    bool is_frozen() const
     {
+        return is_frozen_;
+    }
+
+    ProductPtr create(const IdType& id) const
+    {
+        if constexpr (has_integral_ids)
+        {
+            if (is_frozen_ && !indexed_creators_.empty())
+            {
+                if (id >= indexed_creators_.size() || indexed_creators_[static_cast<std::size_t>(id)] == no_creator)
+                    throw std::out_of_range("Creator not registered");
+
+                return frozen_creators_[indexed_creators_[static_cast<std::size_t>(id)]].second();
+            }
+        }
+
+        if (is_frozen_)
+        {
+            auto pos = std::lower_bound(frozen_creators_.begin(), frozen_creators_.end(), id,
+                [](const auto& item, const IdType& id) { return item.first < id; });
+
+            if (pos == frozen_creators_.end() || pos->first != id)
+                throw std::out_of_range("Creator not registered");
+
+            return pos->second();
+        }
+
         auto& creator = creators_.at(id);
 
         return creator();
@@ -1,14 +1,22 @@
 #include <cassert>
+#include <chrono>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <typeindex>
+#include <typeinfo>
 #include <unordered_map>
 #include <vector>
 
+#include "circle.hpp"
+#include "rectangle.hpp"
 #include "shape.hpp"
 #include "shape_factories.hpp"
+#include "square.hpp"
+#include "static_shape_registry.hpp"
 
 using namespace std;
 using namespace Drawing;
@@ -16,26 +24,46 @@ using namespace Drawing::IO;
 
 class GraphicsDoc
 {
-    vector<unique_ptr<Shape>> shapes_;
+    // type of a shape is resolved once - when it is loaded or added - so save() needs no type lookup
+    struct StoredShape
+    {
+        unique_ptr<Shape> shape;
+        size_t built_in_index; // BuiltInShapes::npos for shapes handled by the dynamic factories
+        ShapeTypeId type_id;
+    };
+
+    vector<StoredShape> shapes_;
+    const ShapeTypeTable& shape_types_;
     ShapeFactory& shape_factory_;
     ShapeRWFactory& shape_rw_factory_;
 
 public:
-    GraphicsDoc(ShapeFactory& shape_factory, ShapeRWFactory& shape_rw_factory)
-        : shape_factory_{shape_factory}
+    GraphicsDoc(const ShapeTypeTable& shape_types, ShapeFactory& shape_factory, ShapeRWFactory& shape_rw_factory)
+        : shape_types_{shape_types}
+        , shape_factory_{shape_factory}
         , shape_rw_factory_{shape_rw_factory}
     {
     }
 
+    // throws std::invalid_argument for a shape type that is neither built-in nor registered - save() could not write it
     void add(unique_ptr<Shape> shp)
     {
-        shapes_.push_back(std::move(shp));
+        const auto index = BuiltInShapes::index_of(*shp);
+        const auto type_id = index == BuiltInShapes::npos ? shape_types_.id(*shp) : SymbolTable::npos;
+
+        if (index == BuiltInShapes::npos && type_id == SymbolTable::npos)
+        {
+            const Shape& unknown = *shp;
+            throw invalid_argument("Unknown shape type: "s + typeid(unknown).name());
+        }
+
+        shapes_.push_back(StoredShape{std::move(shp), index, type_id});
     }
 
     void render()
     {
-        for (const auto& shp : shapes_)
-            shp->draw();
+        for (const auto& stored : shapes_)
+            stored.shape->draw();
     }
 
     void load(const string& filename)
@@ -48,9 +76,10 @@ public:
             exit(1);
         }
 
+        string shape_id; // reused buffer - no allocation per shape
+
         while (file_in)
         {
-            string shape_id;
             file_in >> shape_id;
 
             if (!file_in)
@@ -58,12 +87,23 @@ public:
 
             cout << "Loading " << shape_id << "..." << endl;
 
-            auto shape = shape_factory_.create(shape_id);
-            auto shape_rw = shape_rw_factory_.create(make_type_index(*shape));
+            if (auto index = BuiltInShapes::index_of(shape_id); index != BuiltInShapes::npos)
+            {
+                auto shape = BuiltInShapes::create(index);
+                BuiltInShapes::reader_writer(index).read(*shape, file_in);
+
+                shapes_.push_back(StoredShape{std::move(shape), index, SymbolTable::npos});
+                continue;
+            }
+
+            // fallback - shapes registered at runtime; interned id indexes both factories
+            const auto type_id = shape_types_.id(shape_id);
+            auto shape = shape_factory_.create(type_id);
+            auto shape_rw = shape_rw_factory_.create(type_id);
 
             shape_rw->read(*shape, file_in);
 
-            shapes_.push_back(std::move(shape));
+            shapes_.push_back(StoredShape{std::move(shape), BuiltInShapes::npos, type_id});
         }
     }
 
@@ -71,19 +111,109 @@ public:
     {
         ofstream file_out{filename};
 
-        for (const auto& shp : shapes_)
+        for (const auto& [shape, built_in_index, type_id] : shapes_)
         {
-            auto shape_rw = shape_rw_factory_.create(make_type_index(*shp));
-            shape_rw->write(*shp, file_out);
+            if (built_in_index != BuiltInShapes::npos)
+            {
+                BuiltInShapes::reader_writer(built_in_index).write(*shape, file_out);
+                continue;
+            }
+
+            auto shape_rw = shape_rw_factory_.create(type_id);
+            shape_rw->write(*shape, file_out);
         }
     }
 };
 
-int main()
+void pooled_scene_reload()
+{
+    auto circle_pool = make_shared<ObjectPool<Shape, Circle>>();
+    auto rectangle_pool = make_shared<ObjectPool<Shape, Rectangle>>();
+    auto square_pool = make_shared<ObjectPool<Shape, Square>>();
+
+    PooledShapeFactory pooled_factory;
+    pooled_factory.register_creator(Circle::id, PooledCreator<Shape>{circle_pool});
+    pooled_factory.register_creator(Rectangle::id, PooledCreator<Shape>{rectangle_pool});
+    pooled_factory.register_creator(Square::id, PooledCreator<Shape>{square_pool});
+    pooled_factory.freeze();
+
+    const vector<string> scene = {"Circle", "Rectangle", "Circle", "Square"};
+
+    for (int reload = 0; reload < 1000; ++reload)
+    {
+        vector<PooledShapeFactory::ProductPtr> shapes;
+        for (const auto& id : scene)
+            shapes.push_back(pooled_factory.create(id));
+    }
+
+    cout << "Pool hit rate - Circle: " << circle_pool->stats().hit_rate()
+         << "; Rectangle: " << rectangle_pool->stats().hit_rate()
+         << "; Square: " << square_pool->stats().hit_rate() << endl;
+}
+
+void benchmark_shape_registries()
+{
+    using Clock = std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+
+    constexpr int registration_count = 10'000;
+    auto start = Clock::now();
+    for (int i = 0; i < registration_count; ++i)
+    {
+        ShapeTypeTable shape_types;
+        ShapeFactory shape_factory;
+        ShapeRWFactory shape_rw_factory;
+        BuiltInShapes::register_with(shape_types, shape_factory, shape_rw_factory);
+        shape_factory.freeze();
+        shape_rw_factory.freeze();
+    }
+    auto registration_time = duration_cast<nanoseconds>(Clock::now() - start) / registration_count;
+    cout << "Dynamic registration: " << registration_time.count() << "ns per registry" << endl;
+
+    const vector<string> ids = {"Circle", "Rectangle", "Circle", "Square"};
+    constexpr int lookup_count = 1'000'000;
+    auto& shape_types = SingletonShapeTypeTable::instance();
+    auto& shape_factory = SingletonShapeFactory::instance();
+    auto& shape_rw_factory = SingletonShapeRWFactory::instance();
+    size_t checksum = 0;
+
+    start = Clock::now();
+    for (int i = 0; i < lookup_count; ++i)
+    {
+        const auto type_id = shape_types.id(ids[i % ids.size()]);
+        auto shape = shape_factory.create(type_id);
+        auto shape_rw = shape_rw_factory.create(type_id);
+        checksum += typeid(*shape).hash_code() ^ typeid(*shape_rw).hash_code();
+    }
+    auto dynamic_time = duration_cast<nanoseconds>(Clock::now() - start) / lookup_count;
+    const size_t dynamic_checksum = checksum;
+    checksum = 0;
+
+    start = Clock::now();
+    for (int i = 0; i < lookup_count; ++i)
+    {
+        auto index = BuiltInShapes::index_of(ids[i % ids.size()]);
+        auto shape = BuiltInShapes::create(index);
+        checksum += typeid(*shape).hash_code() ^ typeid(BuiltInShapes::reader_writer(index)).hash_code();
+    }
+    auto static_time = duration_cast<nanoseconds>(Clock::now() - start) / lookup_count;
+
+    cout << "Create + RW lookup - dynamic: " << dynamic_time.count() << "ns; static: " << static_time.count() << "ns"
+         << (dynamic_checksum == checksum ? "" : " - CHECKSUMS DIFFER!") << endl;
+}
+
+int main(int argc, char* argv[])
 {
     cout << "Start..." << endl;
 
-    GraphicsDoc doc(SingletonShapeFactory::instance(), SingletonShapeRWFactory::instance());
+    // built-in shapes are dispatched by BuiltInShapes; dynamic factories are the fallback
+    // and are filled explicitly here - no registration happens during static initialization
+    BuiltInShapes::register_with(SingletonShapeTypeTable::instance(), SingletonShapeFactory::instance(), SingletonShapeRWFactory::instance());
+    SingletonShapeFactory::instance().freeze();
+    SingletonShapeRWFactory::instance().freeze();
+
+    GraphicsDoc doc(SingletonShapeTypeTable::instance(), SingletonShapeFactory::instance(), SingletonShapeRWFactory::instance());
 
     doc.load("drawing_fm_exercise1.txt");
 
@@ -92,4 +222,14 @@ int main()
     doc.render();
 
     doc.save("new_drawing.txt");
+
+    // pool & registry benchmarks create millions of shapes - they are run on request only
+    if (argc < 2 || string{argv[1]} != "--benchmark")
+        return 0;
+
+    cout << "\n";
+
+    pooled_scene_reload();
+
+    benchmark_shape_registries();
 }
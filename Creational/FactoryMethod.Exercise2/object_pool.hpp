@@ -0,0 +1,166 @@
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+template <typename ProductType>
+class ObjectPoolBase
+{
+public:
+    virtual ~ObjectPoolBase() = default;
+    virtual ProductType* acquire() = 0;
+    virtual void release(ProductType* obj) = 0;
+};
+
+// Returns objects to the pool they were acquired from.
+// Holds a weak reference - an object that outlives its pool is simply deleted.
+template <typename ProductType>
+class PoolDeleter
+{
+    std::weak_ptr<ObjectPoolBase<ProductType>> pool_;
+
+public:
+    PoolDeleter() = default;
+
+    explicit PoolDeleter(std::weak_ptr<ObjectPoolBase<ProductType>> pool)
+        : pool_{std::move(pool)}
+    {
+    }
+
+    void operator()(ProductType* obj) const
+    {
+        if (auto pool = pool_.lock())
+            pool->release(obj);
+        else
+            delete obj;
+    }
+};
+
+template <typename ProductType>
+using PooledPtr = std::unique_ptr<ProductType, PoolDeleter<ProductType>>;
+
+struct PoolStats
+{
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+
+    double hit_rate() const
+    {
+        const auto total = hits + misses;
+        return total ? static_cast<double>(hits) / total : 0.0;
+    }
+};
+
+// Free list of raw storage for ConcreteType objects.
+// Released objects are destroyed, but their memory is kept for the next acquire().
+// Storage comes from ::operator new(sizeof(ConcreteType)), so an object released after
+// the pool is gone can be destroyed with delete (ProductType needs a virtual destructor).
+template <typename ProductType, typename ConcreteType>
+class ObjectPool : public ObjectPoolBase<ProductType>
+{
+    static_assert(std::has_virtual_destructor_v<ProductType>, "Pooled products are deleted through ProductType*");
+    static_assert(alignof(ConcreteType) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Over-aligned types are not supported");
+
+    static ConcreteType* allocate()
+    {
+        return static_cast<ConcreteType*>(::operator new(sizeof(ConcreteType)));
+    }
+
+    static void deallocate(ConcreteType* storage)
+    {
+        ::operator delete(storage, sizeof(ConcreteType));
+    }
+
+    std::vector<ConcreteType*> free_list_;
+    PoolStats stats_;
+    mutable std::mutex mtx_;
+
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    ~ObjectPool() override
+    {
+        for (auto* storage : free_list_)
+            deallocate(storage);
+    }
+
+    void reserve(std::size_t count)
+    {
+        std::lock_guard lk{mtx_};
+        free_list_.reserve(free_list_.size() + count);
+        for (std::size_t i = 0; i < count; ++i)
+            free_list_.push_back(allocate());
+    }
+
+    ProductType* acquire() override
+    {
+        ConcreteType* storage = nullptr;
+        {
+            std::lock_guard lk{mtx_};
+            if (!free_list_.empty())
+            {
+                storage = free_list_.back();
+                free_list_.pop_back();
+                ++stats_.hits;
+            }
+            else
+                ++stats_.misses;
+        }
+
+        if (!storage)
+            storage = allocate();
+
+        try
+        {
+            return ::new (static_cast<void*>(storage)) ConcreteType();
+        }
+        catch (...)
+        {
+            std::lock_guard lk{mtx_};
+            free_list_.push_back(storage);
+            throw;
+        }
+    }
+
+    void release(ProductType* obj) override
+    {
+        auto* concrete = static_cast<ConcreteType*>(obj);
+        concrete->~ConcreteType();
+
+        std::lock_guard lk{mtx_};
+        free_list_.push_back(concrete);
+    }
+
+    PoolStats stats() const
+    {
+        std::lock_guard lk{mtx_};
+        return stats_;
+    }
+};
+
+// creator policy for GenericFactory - products are returned to the pool on destruction
+template <typename ProductType>
+class PooledCreator
+{
+    std::shared_ptr<ObjectPoolBase<ProductType>> pool_;
+
+public:
+    explicit PooledCreator(std::shared_ptr<ObjectPoolBase<ProductType>> pool)
+        : pool_{std::move(pool)}
+    {
+    }
+
+    PooledPtr<ProductType> operator()() const
+    {
+        return PooledPtr<ProductType>{pool_->acquire(), PoolDeleter<ProductType>{pool_}};
+    }
+};
+
+#endif // OBJECT_POOL_HPP
@@ -1,15 +1,8 @@
 #include "rectangle.hpp"
-#include "shape_factories.hpp"
 
 using namespace std;
 using namespace Drawing;
 
-namespace
-{
-    bool is_registered = SingletonShapeFactory::instance()
-                             .register_creator(Rectangle::id, [] { return make_unique<Rectangle>(); });
-}
-
 Rectangle::Rectangle(int x, int y, int w, int h)
     : ShapeBase{x, y}
     , width_{w}
@@ -2,30 +2,64 @@
 #define SHAPE_FACTORIES_HPP
 
 #include "generic_factory.hpp"
+#include "object_pool.hpp"
 #include "shape.hpp"
 #include "shape_readers_writers/shape_reader_writer.hpp"
 #include "singleton.hpp"
+#include "symbol_table.hpp"
+#include <string_view>
 #include <typeindex>
+#include <unordered_map>
 
 namespace Drawing
 {
-    using ShapeFactory = GenericFactory<Drawing::Shape>;
-    using SingletonShapeFactory = SingletonHolder<ShapeFactory>;
-
-    using ShapeRWFactory = GenericFactory<Drawing::IO::ShapeReaderWriter, std::type_index>;
-    using SingletonShapeRWFactory = SingletonHolder<ShapeRWFactory>;
+    using ShapeTypeId = SymbolTable::SymbolId;
 
-    template <typename T>
-    std::type_index make_type_index(const T& obj)
+    // Interned shape type ids shared by ShapeFactory & ShapeRWFactory.
+    // Textual id from a file is mapped once to ShapeTypeId, which indexes both factories.
+    class ShapeTypeTable
     {
-        return std::type_index(typeid(obj));
-    }
+        SymbolTable names_;
+        std::unordered_map<std::type_index, ShapeTypeId> ids_by_type_;
 
-    template <typename T>
-    std::type_index make_type_index()
-    {
-        return std::type_index(typeid(T));
-    }
+    public:
+        template <typename TShape>
+        ShapeTypeId register_type()
+        {
+            const auto id = names_.intern(TShape::id);
+            ids_by_type_.emplace(typeid(TShape), id);
+            return id;
+        }
+
+        ShapeTypeId id(std::string_view name) const
+        {
+            return names_.find(name);
+        }
+
+        ShapeTypeId id(const Shape& shp) const
+        {
+            auto it = ids_by_type_.find(typeid(shp));
+            return it != ids_by_type_.end() ? it->second : SymbolTable::npos;
+        }
+
+        const std::string& name(ShapeTypeId id) const
+        {
+            return names_.name(id);
+        }
+    };
+
+    using SingletonShapeTypeTable = SingletonHolder<ShapeTypeTable>;
+
+    // creators are captureless lambdas - plain function pointers avoid std::function overhead
+    using ShapeCreator = std::unique_ptr<Drawing::Shape> (*)();
+    using ShapeFactory = GenericFactory<Drawing::Shape, ShapeTypeId, ShapeCreator>;
+    using SingletonShapeFactory = SingletonHolder<ShapeFactory>;
+
+    using PooledShapeFactory = GenericFactory<Drawing::Shape, std::string, PooledCreator<Drawing::Shape>>;
+
+    using ShapeRWCreator = std::unique_ptr<Drawing::IO::ShapeReaderWriter> (*)();
+    using ShapeRWFactory = GenericFactory<Drawing::IO::ShapeReaderWriter, ShapeTypeId, ShapeRWCreator>;
+    using SingletonShapeRWFactory = SingletonHolder<ShapeRWFactory>;
 }
 
 #endif // SHAPE_FACTORIES_HPP
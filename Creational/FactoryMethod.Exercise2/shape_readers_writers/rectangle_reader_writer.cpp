@@ -1,18 +1,10 @@
 #include "rectangle_reader_writer.hpp"
 #include "../rectangle.hpp"
-#include "../shape_factories.hpp"
 
 using namespace std;
 using namespace Drawing;
 using namespace IO;
 
-namespace
-{
-    bool is_registered = SingletonShapeRWFactory::instance()
-                             .register_creator(make_type_index<Rectangle>(),
-                                 [] { return make_unique<RectangleReaderWriter>(); });
-}
-
 void RectangleReaderWriter::read(Shape& shp, std::istream& in)
 {
     Rectangle& rect = static_cast<Rectangle&>(shp);
@@ -1,16 +1,9 @@
 #include "square.hpp"
-#include "shape_factories.hpp"
 #include <cassert>
 
 using namespace std;
 using namespace Drawing;
 
-namespace
-{
-    bool is_registered = SingletonShapeFactory::instance()
-                             .register_creator(Square::id, [] { return make_unique<Square>(); });
-}
-
 Square::Square(int x, int y, int size)
     : rect_{x, y, size, size}
 {
@@ -0,0 +1,157 @@
+#ifndef STATIC_SHAPE_REGISTRY_HPP
+#define STATIC_SHAPE_REGISTRY_HPP
+
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "shape.hpp"
+#include "shape_factories.hpp"
+#include "shape_readers_writers/circle_reader_writer.hpp"
+#include "shape_readers_writers/rectangle_reader_writer.hpp"
+#include "shape_readers_writers/shape_reader_writer.hpp"
+#include "shape_readers_writers/square_reader_writer.hpp"
+#include "square.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <tuple>
+#include <typeinfo>
+
+namespace Drawing
+{
+    template <typename TShape, typename TShapeRW>
+    struct ShapeEntry
+    {
+        using shape_type = TShape;
+        using reader_writer_type = TShapeRW;
+    };
+
+    namespace Detail
+    {
+        // FNV-1a
+        constexpr std::uint32_t hash_id(std::string_view id)
+        {
+            std::uint32_t hash = 2166136261u;
+            for (char c : id)
+                hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+            return hash;
+        }
+
+        // smallest number of bits of the hash that maps all ids to distinct buckets (a perfect hash)
+        template <std::size_t N>
+        constexpr std::size_t perfect_hash_bits(const std::array<std::string_view, N>& ids)
+        {
+            for (std::size_t bits = 0; bits < 16; ++bits)
+            {
+                const std::uint32_t mask = (1u << bits) - 1;
+                bool is_perfect = true;
+
+                for (std::size_t i = 0; i < N && is_perfect; ++i)
+                    for (std::size_t j = i + 1; j < N && is_perfect; ++j)
+                        is_perfect = (hash_id(ids[i]) & mask) != (hash_id(ids[j]) & mask);
+
+                if (is_perfect)
+                    return bits;
+            }
+
+            return 16; // no perfect hash found - rejected by static_assert in StaticShapeRegistry
+        }
+
+        // bucket -> index of id (N for empty buckets)
+        template <std::size_t Bits, std::size_t N>
+        constexpr std::array<std::uint8_t, (1u << Bits)> make_buckets(const std::array<std::string_view, N>& ids)
+        {
+            std::array<std::uint8_t, (1u << Bits)> buckets{};
+            for (auto& bucket : buckets)
+                bucket = N;
+
+            for (std::size_t i = 0; i < N; ++i)
+                buckets[hash_id(ids[i]) & ((1u << Bits) - 1)] = static_cast<std::uint8_t>(i);
+
+            return buckets;
+        }
+    }
+
+    // Registry of shapes known at compile time - no static-init registration is needed.
+    // Every shape has a fixed index (like std::variant::index()) used for create & RW dispatch.
+    // Textual ids are resolved with a perfect hash computed at compile time - one table load and one string compare.
+    template <typename... Entries>
+    class StaticShapeRegistry
+    {
+        static_assert(sizeof...(Entries) < 255, "Too many shapes for StaticShapeRegistry");
+
+        template <typename TShape>
+        static std::unique_ptr<Shape> make_shape()
+        {
+            return std::make_unique<TShape>();
+        }
+
+        template <typename TShapeRW>
+        static std::unique_ptr<IO::ShapeReaderWriter> make_reader_writer()
+        {
+            return std::make_unique<TShapeRW>();
+        }
+
+        static constexpr std::array<std::string_view, sizeof...(Entries)> ids_ = {std::string_view{Entries::shape_type::id}...};
+        static constexpr std::array<std::unique_ptr<Shape> (*)(), sizeof...(Entries)> creators_ = {&make_shape<typename Entries::shape_type>...};
+
+        static constexpr std::size_t hash_bits_ = Detail::perfect_hash_bits(ids_);
+        static_assert(hash_bits_ < 16, "Shape ids cannot be distinguished by a perfect hash");
+        static constexpr std::array<std::uint8_t, (1u << hash_bits_)> buckets_ = Detail::make_buckets<hash_bits_>(ids_);
+
+        inline static std::tuple<typename Entries::reader_writer_type...> reader_writers_;
+        inline static const std::array<IO::ShapeReaderWriter*, sizeof...(Entries)> reader_writers_table_ = {&std::get<typename Entries::reader_writer_type>(reader_writers_)...};
+
+    public:
+        static constexpr std::size_t size = sizeof...(Entries);
+        static constexpr std::size_t npos = size;
+
+        static constexpr std::size_t index_of(std::string_view id)
+        {
+            const std::size_t index = buckets_[Detail::hash_id(id) & ((1u << hash_bits_) - 1)];
+            return index != npos && ids_[index] == id ? index : npos;
+        }
+
+        static std::size_t index_of(const Shape& shp)
+        {
+            std::size_t index = 0;
+            ((typeid(shp) == typeid(typename Entries::shape_type) || (++index, false)) || ...);
+            return index;
+        }
+
+        template <typename TShape>
+        static constexpr std::size_t index_of()
+        {
+            return index_of(TShape::id);
+        }
+
+        static std::unique_ptr<Shape> create(std::size_t index)
+        {
+            return creators_[index]();
+        }
+
+        static IO::ShapeReaderWriter& reader_writer(std::size_t index)
+        {
+            return *reader_writers_table_[index];
+        }
+
+        // dynamic registration of all shapes - explicit call instead of static-init side effects
+        static void register_with(ShapeTypeTable& shape_types, ShapeFactory& shape_factory, ShapeRWFactory& shape_rw_factory)
+        {
+            (shape_factory.register_creator(shape_types.register_type<typename Entries::shape_type>(), &make_shape<typename Entries::shape_type>), ...);
+            (shape_rw_factory.register_creator(shape_types.register_type<typename Entries::shape_type>(), &make_reader_writer<typename Entries::reader_writer_type>), ...);
+        }
+    };
+
+    using BuiltInShapes = StaticShapeRegistry<
+        ShapeEntry<Circle, IO::CircleReaderWriter>,
+        ShapeEntry<Rectangle, IO::RectangleReaderWriter>,
+        ShapeEntry<Square, IO::SquareReaderWriter>>;
+
+    static_assert(BuiltInShapes::index_of("Rectangle") == 1);
+    static_assert(BuiltInShapes::index_of("Triangle") == BuiltInShapes::npos);
+}
+
+#endif // STATIC_SHAPE_REGISTRY_HPP
@@ -0,0 +1,56 @@
+#ifndef SYMBOL_TABLE_HPP
+#define SYMBOL_TABLE_HPP
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Interns strings - every distinct name is mapped once to a small, dense integer id (0, 1, 2, ...)
+class SymbolTable
+{
+public:
+    using SymbolId = std::uint32_t;
+    static constexpr SymbolId npos = std::numeric_limits<SymbolId>::max();
+
+private:
+    std::deque<std::string> names_; // deque - views in ids_ stay valid when names are added
+    std::unordered_map<std::string_view, SymbolId> ids_;
+
+public:
+    SymbolId intern(std::string_view name)
+    {
+        if (auto it = ids_.find(name); it != ids_.end())
+            return it->second;
+
+        const auto id = static_cast<SymbolId>(names_.size());
+        const auto& stored_name = names_.emplace_back(name);
+        ids_.emplace(stored_name, id);
+
+        return id;
+    }
+
+    SymbolId find(std::string_view name) const
+    {
+        auto it = ids_.find(name);
+        return it != ids_.end() ? it->second : npos;
+    }
+
+    const std::string& name(SymbolId id) const
+    {
+        if (id >= names_.size())
+            throw std::out_of_range("Unknown symbol id");
+
+        return names_[id];
+    }
+
+    std::size_t size() const
+    {
+        return names_.size();
+    }
+};
+
+#endif // SYMBOL_TABLE_HPP
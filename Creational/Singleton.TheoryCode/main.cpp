@@ -1,12 +1,65 @@
 #include "singleton.hpp"
+#include "singleton_holder.hpp"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
-int main()
+struct Configuration
+{
+    int verbosity = 1;
+};
+
+template <typename TSingleton>
+void benchmark_instance(const string& name, unsigned thread_count)
+{
+    constexpr int calls_per_thread = 10'000'000;
+
+    vector<const void*> addresses(thread_count);
+    vector<thread> threads;
+
+    auto start = chrono::steady_clock::now();
+
+    for (unsigned t = 0; t < thread_count; ++t)
+        threads.emplace_back([&addresses, t] {
+            const void* volatile address = nullptr;
+            for (int i = 0; i < calls_per_thread; ++i)
+                address = &TSingleton::instance();
+            addresses[t] = address;
+        });
+
+    for (auto& thd : threads)
+        thd.join();
+
+    auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+
+    sort(addresses.begin(), addresses.end());
+    auto instance_count = distance(addresses.begin(), unique(addresses.begin(), addresses.end()));
+
+    cout << name << ": " << static_cast<double>(elapsed.count()) / calls_per_thread << "ns per instance() call"
+         << " (" << thread_count << " threads, " << instance_count << " instance(s))" << endl;
+}
+
+int main(int argc, char* argv[])
 {
     Singleton::instance().do_something();
 
     Singleton& singleObject = Singleton::instance();
     singleObject.do_something();
+
+    // benchmarks make tens of millions of instance() calls - they are run on request only
+    if (argc < 2 || string{argv[1]} != "--benchmark")
+        return 0;
+
+    const unsigned thread_count = max(2u, thread::hardware_concurrency());
+
+    cout << dec;
+    benchmark_instance<SingletonHolder<Configuration>>("MeyersInit", thread_count);
+    benchmark_instance<SingletonHolder<Configuration, CreationPolicies::EagerInit>>("EagerInit", thread_count);
+    benchmark_instance<SingletonHolder<Configuration, CreationPolicies::ThreadLocalInit>>("ThreadLocalInit", thread_count);
+    benchmark_instance<SingletonHolder<Configuration, CreationPolicies::LazyInit>>("LazyInit", thread_count);
 }
@@ -1,7 +1,9 @@
 #ifndef SINGLETON_HPP_
 #define SINGLETON_HPP_
 
+#include <atomic>
 #include <iostream>
+#include <mutex>
 
 class Singleton
 {
@@ -11,18 +13,29 @@ public:
 
     static Singleton& instance()
     {
-        if (!instance_)
+        // double-checked locking - hot path is a single acquire load
+        Singleton* instance = instance_.load(std::memory_order_acquire);
+
+        if (!instance)
         {
-            instance_ = new Singleton();
+            std::lock_guard<std::mutex> lk{mtx_};
+
+            instance = instance_.load(std::memory_order_relaxed);
+            if (!instance)
+            {
+                instance = new Singleton();
+                instance_.store(instance, std::memory_order_release);
+            }
         }
 
-        return *instance_;
+        return *instance;
     }
 
     void do_something();
 
 private:
-    static Singleton* instance_; // uniqueInstance
+    inline static std::atomic<Singleton*> instance_{nullptr}; // uniqueInstance
+    inline static std::mutex mtx_;
 
     Singleton() // disallows creation of new instances outside the class
     {
@@ -35,9 +48,7 @@ private:
     }
 };
 
-Singleton* Singleton::instance_ = nullptr;
-
-void Singleton::do_something()
+inline void Singleton::do_something()
 {
     std::cout << "Singleton instance at " << std::hex << &instance() << std::endl;
 }
@@ -0,0 +1,110 @@
+#ifndef SINGLETON_HOLDER_HPP_
+#define SINGLETON_HOLDER_HPP_
+
+#include <atomic>
+#include <mutex>
+
+namespace CreationPolicies
+{
+    // function-local static - thread-safe since C++11, guard variable checked on every call
+    template <typename T>
+    class MeyersInit
+    {
+    public:
+        static T& instance()
+        {
+            static T unique_instance;
+
+            return unique_instance;
+        }
+    };
+
+    // T{} is usable in a constant expression
+    template <typename T, int = (static_cast<void>(T{}), 0)>
+    constexpr bool is_constexpr_default_constructible(int)
+    {
+        return true;
+    }
+
+    template <typename T>
+    constexpr bool is_constexpr_default_constructible(...)
+    {
+        return false;
+    }
+
+    // constant-initialized at compile time - no synchronization on access and no static init order problem
+    template <typename T>
+    class EagerInit
+    {
+        static_assert(is_constexpr_default_constructible<T>(0), "EagerInit requires T with a constexpr default constructor");
+
+        inline static constinit T unique_instance_{};
+
+    public:
+        static T& instance()
+        {
+            return unique_instance_;
+        }
+    };
+
+    // one instance per thread - no sharing, no synchronization
+    template <typename T>
+    class ThreadLocalInit
+    {
+    public:
+        static T& instance()
+        {
+            thread_local T unique_instance;
+
+            return unique_instance;
+        }
+    };
+
+    // double-checked locking - hot path is a single acquire load
+    // instance is never destroyed (no dead-reference problem at exit)
+    template <typename T>
+    class LazyInit
+    {
+        inline static std::atomic<T*> unique_instance_{nullptr};
+        inline static std::mutex mtx_;
+
+    public:
+        static T& instance()
+        {
+            T* instance = unique_instance_.load(std::memory_order_acquire);
+
+            if (!instance)
+            {
+                std::lock_guard<std::mutex> lk{mtx_};
+
+                instance = unique_instance_.load(std::memory_order_relaxed);
+                if (!instance)
+                {
+                    instance = new T();
+                    unique_instance_.store(instance, std::memory_order_release);
+                }
+            }
+
+            return *instance;
+        }
+    };
+}
+
+template <typename T, template <typename> class CreationPolicy = CreationPolicies::MeyersInit>
+class SingletonHolder
+{
+private:
+    SingletonHolder() = default;
+    ~SingletonHolder() = default;
+
+public:
+    SingletonHolder(const SingletonHolder&) = delete;
+    SingletonHolder& operator=(const SingletonHolder&) = delete;
+
+    static T& instance()
+    {
+        return CreationPolicy<T>::instance();
+    }
+};
+
+#endif /*SINGLETON_HOLDER_HPP_*/
@@ -0,0 +1,115 @@
+#include "singleton_holder.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // every policy gets its own type - so each test starts with a fresh lazy instance
+    template <typename Tag>
+    struct Tracked
+    {
+        inline static std::atomic<int> constructions_count{0};
+
+        int value; // plain member written in the constructor - TSan reports unsynchronized publication
+
+        Tracked()
+            : value{42}
+        {
+            ++constructions_count;
+        }
+    };
+
+    // EagerInit needs a constexpr default constructor - Tracked counts constructions at run time
+    struct EagerConfiguration
+    {
+        int value = 42;
+    };
+
+    struct MeyersTag;
+    struct LazyTag;
+    struct ThreadLocalTag;
+
+    constexpr unsigned threads_count = 8;
+
+    // all threads are released at once to maximize contention on the first instance() call
+    template <typename TSingleton>
+    std::vector<const void*> call_instance_concurrently(std::vector<int>& values)
+    {
+        std::vector<const void*> addresses(threads_count);
+        std::atomic<bool> is_started{false};
+        std::vector<std::thread> threads;
+
+        for (unsigned t = 0; t < threads_count; ++t)
+            threads.emplace_back([&, t] {
+                while (!is_started)
+                    std::this_thread::yield();
+
+                auto& instance = TSingleton::instance();
+                addresses[t] = &instance;
+                values[t] = instance.value;
+            });
+
+        is_started = true;
+
+        for (auto& thd : threads)
+            thd.join();
+
+        return addresses;
+    }
+
+    size_t distinct_count(std::vector<const void*> addresses)
+    {
+        std::sort(addresses.begin(), addresses.end());
+        return std::distance(addresses.begin(), std::unique(addresses.begin(), addresses.end()));
+    }
+
+    template <template <typename> class CreationPolicy, typename Tag>
+    void check_shared_instance()
+    {
+        using Singleton = SingletonHolder<Tracked<Tag>, CreationPolicy>;
+
+        std::vector<int> values(threads_count);
+        auto addresses = call_instance_concurrently<Singleton>(values);
+
+        REQUIRE(distinct_count(addresses) == 1);
+        REQUIRE(Tracked<Tag>::constructions_count == 1);
+        REQUIRE(std::all_of(values.begin(), values.end(), [](int value) { return value == 42; }));
+    }
+}
+
+TEST_CASE("MeyersInit - one instance shared by all threads", "[singleton]")
+{
+    check_shared_instance<CreationPolicies::MeyersInit, MeyersTag>();
+}
+
+TEST_CASE("EagerInit - one constant-initialized instance shared by all threads", "[singleton]")
+{
+    using Singleton = SingletonHolder<EagerConfiguration, CreationPolicies::EagerInit>;
+
+    std::vector<int> values(threads_count);
+    auto addresses = call_instance_concurrently<Singleton>(values);
+
+    REQUIRE(distinct_count(addresses) == 1);
+    REQUIRE(std::all_of(values.begin(), values.end(), [](int value) { return value == 42; }));
+}
+
+TEST_CASE("LazyInit - one instance shared by all threads", "[singleton]")
+{
+    check_shared_instance<CreationPolicies::LazyInit, LazyTag>();
+}
+
+TEST_CASE("ThreadLocalInit - one instance per thread", "[singleton]")
+{
+    using Singleton = SingletonHolder<Tracked<ThreadLocalTag>, CreationPolicies::ThreadLocalInit>;
+
+    std::vector<int> values(threads_count);
+    auto addresses = call_instance_concurrently<Singleton>(values);
+
+    REQUIRE(Tracked<ThreadLocalTag>::constructions_count == threads_count);
+    REQUIRE(std::all_of(values.begin(), values.end(), [](int value) { return value == 42; }));
+    // addresses are not compared - a finished thread's instance may be reused by a later thread
+}
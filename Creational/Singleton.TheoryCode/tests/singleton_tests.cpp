@@ -0,0 +1,32 @@
+#include "singleton.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Singleton - double-checked locking creates one instance for racing threads", "[singleton]")
+{
+    constexpr unsigned threads_count = 8;
+
+    std::vector<const Singleton*> addresses(threads_count);
+    std::atomic<bool> is_started{false};
+    std::vector<std::thread> threads;
+
+    // all threads are released at once - the first calls race on the creation of the instance
+    for (unsigned t = 0; t < threads_count; ++t)
+        threads.emplace_back([&, t] {
+            while (!is_started)
+                std::this_thread::yield();
+
+            addresses[t] = &Singleton::instance();
+        });
+
+    is_started = true;
+
+    for (auto& thd : threads)
+        thd.join();
+
+    for (const auto* address : addresses)
+        REQUIRE(address == &Singleton::instance());
+}
@@ -1,15 +1,19 @@
 #include <cassert>
+#include <chrono>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <typeindex>
 #include <unordered_map>
 #include <vector>
 
+#include "paragraph.hpp"
 #include "shape.hpp"
 #include "shape_factories.hpp"
 #include "shape_group.hpp"
+#include "text.hpp"
 
 using namespace std;
 using namespace Drawing;
@@ -67,7 +71,36 @@ public:
     }
 };
 
-int main()
+void text_memory_report()
+{
+    constexpr size_t label_count = 1'000'000;
+
+    ShapeGroup scene;
+    for (size_t i = 0; i < label_count; ++i)
+    {
+        auto label = (i % 2 == 0) ? "Label" + to_string(i % 1000) : "Long label describing item #" + to_string(i % 1000);
+        scene.add(make_unique<Text>(0, 0, label));
+    }
+
+    size_t text_bytes = 0;
+    for (const auto& shp : scene)
+        text_bytes += sizeof(Text) + static_cast<const Text&>(*shp).content().heap_bytes();
+
+    // estimate, not a measurement: Paragraph object plus its fixed 1 KB heap buffer (allocator overhead not included)
+    const size_t legacy_text_bytes_estimate = sizeof(ShapeBase<Text>) + sizeof(LegacyCode::Paragraph) + 1024;
+
+    auto start = chrono::steady_clock::now();
+    auto scene_copy = scene.clone();
+    auto clone_time = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+
+    cout << "Memory per Text shape (" << label_count << " labels) - Paragraph buffer (estimate): " << legacy_text_bytes_estimate
+         << "B; TextStorage: " << text_bytes / label_count << "B; scene clone: " << clone_time.count() << "ms" << endl;
+
+    auto pool_stats = SingletonTextPool::instance().stats();
+    cout << "Text pool - unique texts: " << pool_stats.unique_texts << "; hit rate: " << pool_stats.hit_rate() << endl;
+}
+
+int main(int argc, char* argv[])
 {
     cout << "Start..." << endl;
 
@@ -80,4 +113,12 @@ int main()
     doc.render();
 
     doc.save("new_drawing_composite.txt");
+
+    // the report creates a million Text shapes - it is run on request only
+    if (argc < 2 || string{argv[1]} != "--benchmark")
+        return 0;
+
+    cout << "\n";
+
+    text_memory_report();
 }
@@ -22,7 +22,7 @@ void Drawing::IO::TextReaderWriter::read(Drawing::Shape& shp, std::istream& in)
     in >> pt >> str;
 
     text_paragraph.set_coord(pt);
-    text_paragraph.set_text(str.c_str());
+    text_paragraph.set_text(str); // repeated labels are shared via SingletonTextPool
 }
 
 void TextReaderWriter::write(const Shape& shp, ostream& out)
@@ -1,4 +1,5 @@
 #include "text.hpp"
+#include "paragraph.hpp"
 #include "shape_factories.hpp"
 
 using namespace std;
@@ -11,21 +12,29 @@ namespace
 }
 
 Text::Text(int x, int y, const string& text)
-    : ShapeBase{x, y}, LegacyCode::Paragraph{text.c_str()}
+    : ShapeBase{x, y}
 {
+    content_.assign(text, SingletonTextPool::instance());
 }
 
 string Text::text() const
 {
-    return get_paragraph();
+    return string{content_.view()};
 }
 
 void Text::set_text(const string& text)
 {
-    set_paragraph(text.c_str());
+    content_.assign(text, SingletonTextPool::instance());
+}
+
+const TextStorage& Text::content() const
+{
+    return content_;
 }
 
 void Text::draw() const
 {
-    render_at(coord().x, coord().y);
+    // the legacy paragraph is built only for rendering - the content itself stays in TextStorage
+    const LegacyCode::Paragraph paragraph{content_.c_str()};
+    paragraph.render_at(coord().x, coord().y);
 }
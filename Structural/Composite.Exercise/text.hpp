@@ -1,13 +1,19 @@
 #ifndef TEXT_HPP
 #define TEXT_HPP
 
-#include "paragraph.hpp"
 #include "shape.hpp"
+#include "text_storage.hpp"
+#include <string>
 
 namespace Drawing
 {
-    class Text : public ShapeBase<Text>, private LegacyCode::Paragraph
+    // content is kept in TextStorage instead of Paragraph's 1 KB heap buffer
+    // long texts are shared through SingletonTextPool (flyweight)
+    // rendering is delegated to LegacyCode::Paragraph (adapter)
+    class Text : public ShapeBase<Text>
     {
+        TextStorage content_;
+
     public:
         static constexpr const char* id = "Text";
 
@@ -17,6 +23,8 @@ namespace Drawing
 
         void set_text(const std::string& text);
 
+        const TextStorage& content() const;
+
         void draw() const override;
     };
 }
@@ -0,0 +1,97 @@
+#ifndef TEXT_POOL_HPP
+#define TEXT_POOL_HPP
+
+#include "singleton.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Drawing
+{
+    struct TextPoolStats
+    {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t unique_texts = 0;
+
+        double hit_rate() const
+        {
+            const auto total = hits + misses;
+            return total ? static_cast<double>(hits) / total : 0.0;
+        }
+    };
+
+    // Flyweight pool for text content - equal texts are stored once.
+    // Pooled texts are ref-counted: a text is removed from the pool when its last owner is gone.
+    // Deleters keep only a weak reference to the pool state - texts may outlive the pool
+    // (e.g. a text held by another static object destroyed after SingletonTextPool).
+    class TextPool
+    {
+        struct State
+        {
+            std::unordered_map<std::string_view, std::weak_ptr<const std::string>> texts; // keys view pooled strings
+            std::size_t hits = 0;
+            std::size_t misses = 0;
+            std::mutex mtx;
+        };
+
+        std::shared_ptr<State> state_ = std::make_shared<State>();
+
+        static void release(const std::weak_ptr<State>& pool_state, const std::string* text)
+        {
+            if (auto state = pool_state.lock())
+            {
+                std::lock_guard lk{state->mtx};
+
+                // entry may already point to a newer copy of the same text
+                if (auto it = state->texts.find(*text); it != state->texts.end() && it->second.expired())
+                    state->texts.erase(it);
+            }
+
+            delete text;
+        }
+
+    public:
+        TextPool() = default;
+        TextPool(const TextPool&) = delete;
+        TextPool& operator=(const TextPool&) = delete;
+
+        std::shared_ptr<const std::string> intern(std::string_view text)
+        {
+            std::lock_guard lk{state_->mtx};
+
+            if (auto it = state_->texts.find(text); it != state_->texts.end())
+            {
+                if (auto pooled_text = it->second.lock())
+                {
+                    ++state_->hits;
+                    return pooled_text;
+                }
+
+                state_->texts.erase(it); // expired - its owner is being released right now
+            }
+
+            ++state_->misses;
+
+            std::shared_ptr<const std::string> pooled_text{
+                new std::string{text}, [pool_state = std::weak_ptr<State>{state_}](const std::string* t) { release(pool_state, t); }};
+            state_->texts.emplace(*pooled_text, pooled_text);
+
+            return pooled_text;
+        }
+
+        TextPoolStats stats() const
+        {
+            std::lock_guard lk{state_->mtx};
+            return TextPoolStats{state_->hits, state_->misses, state_->texts.size()};
+        }
+    };
+
+    using SingletonTextPool = SingletonHolder<TextPool>;
+}
+
+#endif // TEXT_POOL_HPP
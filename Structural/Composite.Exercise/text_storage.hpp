@@ -0,0 +1,101 @@
+#ifndef TEXT_STORAGE_HPP
+#define TEXT_STORAGE_HPP
+
+#include "text_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace Drawing
+{
+    // Storage for a content of Text shapes:
+    //  * short texts are kept inline - no heap allocation
+    //  * longer texts are kept in an immutable, shared buffer - copies (e.g. clone()) only bump a ref-count
+    class TextStorage
+    {
+    public:
+        static constexpr std::size_t inline_capacity = 22;
+
+    private:
+        struct InlineText
+        {
+            char chars[inline_capacity + 1]; // null-terminated
+            std::uint8_t size;
+        };
+
+        std::variant<InlineText, std::shared_ptr<const std::string>> content_;
+
+    public:
+        explicit TextStorage(std::string_view text = "")
+        {
+            assign(text);
+        }
+
+        explicit TextStorage(std::shared_ptr<const std::string> shared_text)
+            : content_{std::move(shared_text)}
+        {
+        }
+
+        void assign(std::string_view text)
+        {
+            if (text.size() <= inline_capacity)
+            {
+                InlineText inline_text{};
+                std::memcpy(inline_text.chars, text.data(), text.size());
+                inline_text.size = static_cast<std::uint8_t>(text.size());
+                content_ = inline_text;
+            }
+            else
+                content_ = std::make_shared<const std::string>(text);
+        }
+
+        // longer texts are taken from the pool - equal texts share one buffer
+        void assign(std::string_view text, TextPool& pool)
+        {
+            if (text.size() <= inline_capacity)
+                assign(text);
+            else
+                content_ = pool.intern(text);
+        }
+
+        std::string_view view() const
+        {
+            if (auto inline_text = std::get_if<InlineText>(&content_))
+                return std::string_view{inline_text->chars, inline_text->size};
+
+            return *std::get<std::shared_ptr<const std::string>>(content_);
+        }
+
+        const char* c_str() const
+        {
+            if (auto inline_text = std::get_if<InlineText>(&content_))
+                return inline_text->chars;
+
+            return std::get<std::shared_ptr<const std::string>>(content_)->c_str();
+        }
+
+        bool is_inline() const
+        {
+            return std::holds_alternative<InlineText>(content_);
+        }
+
+        // heap memory attributed to this object - a shared buffer is split between its owners
+        std::size_t heap_bytes() const
+        {
+            if (is_inline())
+                return 0;
+
+            const auto& shared_text = std::get<std::shared_ptr<const std::string>>(content_);
+            const auto shared_bytes = sizeof(std::string) + shared_text->capacity() + 1;
+
+            return shared_bytes / static_cast<std::size_t>(shared_text.use_count());
+        }
+    };
+}
+
+#endif // TEXT_STORAGE_HPP